@@ -25,6 +25,10 @@
 
 #include "Initializer.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 using namespace std;
 using namespace VieVS;
@@ -932,6 +936,7 @@ void Initializer::createSatellitesToAvoid( ofstream &of ) noexcept {
     vector<string> satellites;
     vector<string> src_created;
     vector<string> src_failed;
+    unordered_map<string, shared_ptr<Satellite>> name2satellite;
 
     const auto &sat_xml_o = xml_.get_optional<string>( "VieSchedpp.catalogs.satellite_avoid" );
     if ( sat_xml_o.is_initialized() ) {
@@ -983,14 +988,9 @@ void Initializer::createSatellitesToAvoid( ofstream &of ) noexcept {
 
                         ++count_tle;
                         // check if satellite was already generated
-                        bool existed = false;
-                        for ( auto &any : AvoidSatellites::satellitesToAvoid ) {
-                            if ( any->hasName( header ) ) {
-                                any->addpSGP4Data( header, line1, line2 );
-                                existed = true;
-                            }
-                        }
-                        if ( existed ) {
+                        auto existing = name2satellite.find( header );
+                        if ( existing != name2satellite.end() ) {
+                            existing->second->addpSGP4Data( header, line1, line2 );
                             continue;
                         }
                         ++counter;
@@ -1000,7 +1000,8 @@ void Initializer::createSatellitesToAvoid( ofstream &of ) noexcept {
                             src_flux[band] = make_unique<Flux_constant>( ObservingMode::wavelengths[band], 0 );
                         }
                         auto src = make_shared<Satellite>( header, line1, line2, src_flux );
-                        // AvoidSatellites::satellitesToAvoid.push_back( src );
+                        AvoidSatellites::satellitesToAvoid.push_back( src );
+                        name2satellite[header] = src;
                         created++;
                         src_created.push_back( header );
 #ifdef VIESCHEDPP_LOG
@@ -1135,6 +1136,38 @@ void Initializer::initializeGeneral( ofstream &of ) noexcept {
             xml_.get( "VieSchedpp.general.doNotObserveSourcesWithinMinRepeat", true );
         parameters_.ignoreSuccessiveScansSameSrc =
             xml_.get( "VieSchedpp.general.ignore_successive_scans_same_source", true );
+        parameters_.candidatePruning = xml_.get( "VieSchedpp.general.candidatePruning", false );
+        parameters_.candidatePruningFactor = xml_.get( "VieSchedpp.general.candidatePruningFactor", 0.5 );
+
+        std::string azelModel = xml_.get<std::string>( "VieSchedpp.general.azelModel", "rigorous" );
+        if ( azelModel == "interpolated" ) {
+            Station::trackingModel = Station::AzelModel::interpolated;
+        } else {
+            Station::trackingModel = Station::AzelModel::rigorous;
+            if ( azelModel != "rigorous" ) {
+                of << "ERROR: cannot read azimuth/elevation model:" << azelModel << endl;
+            }
+        }
+        parameters_.validateAzElModel = xml_.get( "VieSchedpp.general.validateAzElModel", false );
+        AzElCache::directory = xml_.get( "VieSchedpp.general.azelCacheDirectory", std::string() );
+
+        DurationCache::enabled = xml_.get( "VieSchedpp.general.durationCache", false );
+        DurationCache::maxEntries = xml_.get( "VieSchedpp.general.durationCacheSize", 65536ul );
+        DurationCache::timeQuantization = xml_.get( "VieSchedpp.general.durationCacheTimeQuantization", 0u );
+        DurationCache::elevationQuantization =
+            xml_.get( "VieSchedpp.general.durationCacheElevationQuantization", 0. ) * deg2rad;
+        if ( DurationCache::enabled ) {
+#ifdef VIESCHEDPP_LOG
+            BOOST_LOG_TRIVIAL( info ) << "observing duration cache: time quantization "
+                                      << DurationCache::timeQuantization << " [s], elevation quantization "
+                                      << DurationCache::elevationQuantization * rad2deg << " [deg], "
+                                      << DurationCache::maxEntries << " entries";
+#else
+            cout << "[info] observing duration cache: time quantization " << DurationCache::timeQuantization
+                 << " [s], elevation quantization " << DurationCache::elevationQuantization * rad2deg << " [deg], "
+                 << DurationCache::maxEntries << " entries\n";
+#endif
+        }
 
     } catch ( const boost::property_tree::ptree_error &e ) {
         of << "ERROR: reading VieSchedpp.xml file!" << endl;
@@ -1310,26 +1343,161 @@ void Initializer::initializeStations() noexcept {
 
 
 void Initializer::precalcAzElStations() noexcept {
-    for ( auto &sta : network_.refStations() ) {
-        for ( const auto &source : sourceList_.getQuasars() ) {
-            int step = 600;
-            PointingVector npv( sta.getId(), source->getId() );
-            for ( unsigned int t = 0; t < TimeSystem::duration + 1800; t += step ) {
-                npv.setTime( t );
-                sta.calcAzEl_rigorous( source, npv );
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // each station only writes its own lookup tables
+    vector<Station> &stations = network_.refStations();
+    const auto &quasars = sourceList_.getQuasars();
+    const auto &satellites = sourceList_.getSatellites();
+    unsigned int end = TimeSystem::duration + 1800;
+
+    // satellite orbits are station independent
+    const auto &refSatellites = sourceList_.refSatellites();
+#ifdef _OPENMP
+#pragma omp parallel for schedule( dynamic ) if ( !omp_in_parallel() && refSatellites.size() > 1 )
+#endif
+    for ( int i = 0; i < static_cast<int>( refSatellites.size() ); ++i ) {
+        refSatellites[i]->precalcEphemeris( end );
+    }
+
+    int nThreads = 1;
+    int nCached = 0;
+#ifdef _OPENMP
+    if ( !omp_in_parallel() ) {
+        nThreads = max( 1, min( omp_get_max_threads(), static_cast<int>( stations.size() ) ) );
+    }
+#pragma omp parallel for schedule( dynamic ) num_threads( nThreads ) if ( nThreads > 1 ) reduction( + : nCached )
+#endif
+    for ( int i = 0; i < static_cast<int>( stations.size() ); ++i ) {
+        Station &sta = stations[i];
+        unique_ptr<AzElCache> cache;
+        if ( !AzElCache::directory.empty() ) {
+            cache = make_unique<AzElCache>( sta, quasars, satellites, 600, 60, end );
+            if ( cache->load( sta ) ) {
+                ++nCached;
+                continue;
             }
         }
-        for ( const auto &source : sourceList_.getSatellites() ) {
-//            ofstream o("/scratch/programming/tmp/"+sta.getName()+".csv");
-            int step = 60;
-            PointingVector npv( sta.getId(), source->getId() );
-            for ( unsigned int t = 0; t < TimeSystem::duration + 1800; t += step ) {
-                npv.setTime( t );
-                sta.calcAzEl_rigorous( source, npv );
-//                o << boost::format("%f,%f,%f\n")% (TimeSystem::mjdStart+t/86400) % (npv.getAz()*rad2deg) % (npv.getEl()*rad2deg);
-            }
+        sta.precalcAzEl( quasars, 600, end );
+        for ( const auto &source : satellites ) {
+            sta.precalcAzEl( source, 60, end );
+        }
+        if ( cache != nullptr && !cache->save( sta ) ) {
+#ifdef VIESCHEDPP_LOG
+            BOOST_LOG_TRIVIAL( warning ) << "cannot write azimuth/elevation cache file " << cache->getFileName();
+#else
+            cout << "[warning] cannot write azimuth/elevation cache file " << cache->getFileName() << "\n";
+#endif
         }
     }
+
+    auto finish = std::chrono::high_resolution_clock::now();
+    auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>( finish - start );
+    long long int usec = microseconds.count();
+    string msg = ( boost::format( "precalculated azimuth and elevation of %d stations (%d from cache) using %d "
+                                  "threads (%s)" ) %
+                   stations.size() % nCached % nThreads % util::milliseconds2string( usec, true ) )
+                     .str();
+#ifdef VIESCHEDPP_LOG
+    BOOST_LOG_TRIVIAL( info ) << msg;
+#else
+    cout << "[info] " << msg << "\n";
+#endif
+
+    if ( parameters_.validateAzElModel ) {
+        validateAzElInterpolation();
+    }
+}
+
+
+void Initializer::initializeSatelliteAvoidance() noexcept {
+    if ( AvoidSatellites::satellitesToAvoid.empty() ) {
+        return;
+    }
+    double angularDistance =
+        xml_.get( "VieSchedpp.satelliteAvoidance.angularDistance", AvoidSatellites::angular_distance * rad2deg ) *
+        deg2rad;
+    if ( angularDistance < 0 || !std::isfinite( angularDistance ) ) {
+#ifdef VIESCHEDPP_LOG
+        BOOST_LOG_TRIVIAL( warning ) << "invalid satellite avoidance angular distance " << angularDistance * rad2deg
+                                     << " [deg] -> satellites are not avoided";
+#else
+        cout << "[warning] invalid satellite avoidance angular distance " << angularDistance * rad2deg
+             << " [deg] -> satellites are not avoided\n";
+#endif
+        angularDistance = 0;
+    }
+    AvoidSatellites::angular_distance = angularDistance;
+    AvoidSatellites::timeStep = xml_.get( "VieSchedpp.satelliteAvoidance.timeStep", AvoidSatellites::timeStep );
+    double cellSize =
+        xml_.get( "VieSchedpp.satelliteAvoidance.cellSize", AvoidSatellites::cellSize * rad2deg ) * deg2rad;
+    if ( cellSize <= 0 || !std::isfinite( cellSize ) ) {
+#ifdef VIESCHEDPP_LOG
+        BOOST_LOG_TRIVIAL( warning ) << "invalid satellite avoidance cell size " << cellSize * rad2deg
+                                     << " [deg] -> use " << AvoidSatellites::cellSize * rad2deg << " [deg]";
+#else
+        cout << "[warning] invalid satellite avoidance cell size " << cellSize * rad2deg << " [deg] -> use "
+             << AvoidSatellites::cellSize * rad2deg << " [deg]\n";
+#endif
+        cellSize = AvoidSatellites::cellSize;
+    }
+    AvoidSatellites::cellSize = cellSize;
+#ifdef VIESCHEDPP_LOG
+    BOOST_LOG_TRIVIAL( info ) << boost::format( "avoid %d satellites with angular distance %.2f [deg]" ) %
+                                     AvoidSatellites::satellitesToAvoid.size() %
+                                     ( AvoidSatellites::angular_distance * rad2deg );
+#else
+    cout << boost::format( "[info] avoid %d satellites with angular distance %.2f [deg]\n" ) %
+                AvoidSatellites::satellitesToAvoid.size() % ( AvoidSatellites::angular_distance * rad2deg );
+#endif
+
+    AvoidSatellites::initialize( network_, TimeSystem::duration + 1800 );
+}
+
+
+void Initializer::validateAzElInterpolation() const noexcept {
+    // compare at off-grid epochs
+    constexpr unsigned int step = 97;
+    const vector<Station> &stations = network_.getStations();
+    const auto &quasars = sourceList_.getQuasars();
+
+    vector<double> maxAz( stations.size(), 0 );
+    vector<double> maxEl( stations.size(), 0 );
+    vector<unsigned long> counts( stations.size(), 0 );
+#ifdef _OPENMP
+#pragma omp parallel for schedule( dynamic ) if ( !omp_in_parallel() )
+#endif
+    for ( int i = 0; i < static_cast<int>( stations.size() ); ++i ) {
+        for ( const auto &source : quasars ) {
+            auto error = stations[i].validateAzElInterpolation( source, step );
+            maxAz[i] = max( maxAz[i], get<0>( error ) );
+            maxEl[i] = max( maxEl[i], get<1>( error ) );
+            counts[i] += get<2>( error );
+        }
+    }
+
+    double totalAz = 0;
+    double totalEl = 0;
+    for ( unsigned long i = 0; i < stations.size(); ++i ) {
+        totalAz = max( totalAz, maxAz[i] );
+        totalEl = max( totalEl, maxEl[i] );
+#ifdef VIESCHEDPP_LOG
+        string msg = ( boost::format( "az/el interpolation error %-8s: az*cos(el) %9.6f [arcsec] el %9.6f [arcsec] "
+                                      "(%d epochs)" ) %
+                       stations[i].getName() % ( maxAz[i] * rad2deg * 3600 ) % ( maxEl[i] * rad2deg * 3600 ) %
+                       counts[i] )
+                         .str();
+        if ( Flags::logDebug ) BOOST_LOG_TRIVIAL( debug ) << msg;
+#endif
+    }
+    string msg = ( boost::format( "maximum az/el interpolation error: az*cos(el) %.6f [arcsec] el %.6f [arcsec]" ) %
+                   ( totalAz * rad2deg * 3600 ) % ( totalEl * rad2deg * 3600 ) )
+                     .str();
+#ifdef VIESCHEDPP_LOG
+    BOOST_LOG_TRIVIAL( info ) << msg;
+#else
+    cout << "[info] " << msg << "\n";
+#endif
 }
 
 
@@ -3760,6 +3928,7 @@ void Initializer::connectObservingMode( std::ofstream &of ) noexcept {
     }
     obsModes_->setStationNames( staNames );
     obsModes_->summary( of );
+    ObservingMode::indexBands();
 }
 
 
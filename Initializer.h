@@ -32,6 +32,7 @@
 #include <boost/date_time.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
+#include <chrono>
 #include <memory>
 #include <numeric>
 #include <thread>
@@ -64,6 +65,7 @@
 #include "Station/Antenna/Antenna_HaDc.h"
 #include "Station/Antenna/Antenna_ONSALA_VGOS.h"
 #include "Station/Antenna/Antenna_XYew.h"
+#include "Station/AzElCache.h"
 #include "Station/Baseline.h"
 #include "Station/CableWrap/CableWrap_AzEl.h"
 #include "Station/CableWrap/CableWrap_HaDc.h"
@@ -141,6 +143,10 @@ class Initializer : public VieVS_Object {
         bool doNotObserveSourcesWithinMinRepeat =
             true;  ///< consider scans (with reduced weight) if they are within min repeat time
 
+        bool candidatePruning = false;        ///< backup value for pruning of scan candidates
+        double candidatePruningFactor = 0.5;  ///< backup value for pruning threshold factor
+        bool validateAzElModel = false;       ///< compare interpolated with rigorous azimuth and elevation
+
         bool andAsConditionCombination = true;  ///< backup for condition combination. TRUE = and, FALSE = or
     };
 
@@ -211,10 +217,28 @@ class Initializer : public VieVS_Object {
     /**
      * @brief precalc azimuth elevations for stations
      * @author Matthias Schartner
+     *
+     * Stations are processed in parallel (OpenMP), each station only fills its own lookup tables.
      */
     void precalcAzElStations() noexcept;
 
 
+    /**
+     * @brief compare interpolated azimuth and elevation with rigorous model and log maximum deviations
+     * @author Matthias Schartner
+     *
+     * Called from precalcAzElStations() if VieSchedpp.general.validateAzElModel is set.
+     */
+    void validateAzElInterpolation() const noexcept;
+
+
+    /**
+     * @brief read satellite avoidance parameters and build spatial index of satellites to be avoided
+     * @author Matthias Schartner
+     */
+    void initializeSatelliteAvoidance() noexcept;
+
+
     /**
      * @brief initializes all baselines with settings from VieSchedpp.xml file
      * @author Matthias Schartner
@@ -341,6 +341,7 @@ void SkdParser::read() {
     init.initializeSkyCoverages();
     Initializer::initializeAstronomicalParameteres();
     init.precalcAzElStations();
+    ObservingMode::indexBands();
 
     network_ = move( init.network_ );
     for (auto &sta : network_.refStations()){
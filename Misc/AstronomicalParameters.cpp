@@ -32,12 +32,23 @@ std::vector<double> AstronomicalParameters::sun_ra;          ///< right ascensio
 std::vector<double> AstronomicalParameters::sun_dec;         ///< right ascension and declination of sun
 std::vector<unsigned int> AstronomicalParameters::sun_time;  ///< right ascension and declination of sun
 
-unsigned int AstronomicalParameters::getNutInterpolationIdx( unsigned int time ) {
-    unsigned int nut_precalc_idx = 0;
-    while ( AstronomicalParameters::earth_nutTime[nut_precalc_idx + 1] < time ) {
-        ++nut_precalc_idx;
+unsigned int AstronomicalParameters::getInterpolationIdx( const std::vector<unsigned int> &times, unsigned int time ) {
+    // equidistant times: index of first interval whose end is not before time
+    unsigned int delta = times[1] - times[0];
+    if ( time <= times[0] + delta ) {
+        return 0;
     }
-    return nut_precalc_idx;
+    auto idx = static_cast<unsigned int>( ( time - times[0] - 1 ) / delta );
+    auto maxIdx = static_cast<unsigned int>( times.size() - 2 );
+    return idx < maxIdx ? idx : maxIdx;
+}
+
+unsigned int AstronomicalParameters::getNutInterpolationIdx( unsigned int time ) {
+    return getInterpolationIdx( earth_nutTime, time );
+}
+
+unsigned int AstronomicalParameters::getSunInterpolationIdx( unsigned int time ) {
+    return getInterpolationIdx( sun_time, time );
 }
 
 double AstronomicalParameters::getNutX( unsigned int time, unsigned int interpolationIdx ) {
@@ -55,7 +55,18 @@ class AstronomicalParameters {
     static std::vector<double> sun_dec;         ///< declination of sun in radians
     static std::vector<unsigned int> sun_time;  ///< corresponding times of sun_ra and sun_rc entries
 
+    /**
+     * @brief index of interpolation interval in equidistant lookup table (constant time)
+     * @author Matthias Schartner
+     *
+     * @param times equidistant times of lookup table
+     * @param time target time
+     * @return index of first interval whose end is not before time
+     */
+    static unsigned int getInterpolationIdx( const std::vector<unsigned int> &times, unsigned int time );
+
     static unsigned int getNutInterpolationIdx( unsigned int time );
+    static unsigned int getSunInterpolationIdx( unsigned int time );
     static double getNutX( unsigned int time, unsigned int interpolationIdx );
     static double getNutY( unsigned int time, unsigned int interpolationIdx );
     static double getNutS( unsigned int time, unsigned int interpolationIdx );
@@ -4,10 +4,258 @@
 
 #include "AvoidSatellites.h"
 
+#include <chrono>
+
+#include "util.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace VieVS;
 using namespace std;
 
 std::vector<std::shared_ptr<VieVS::Satellite>> AvoidSatellites::satellitesToAvoid =
     std::vector<std::shared_ptr<VieVS::Satellite>>();  ///< list of satellites to be avoided during scheduling
 
-double angular_distance = 1;  /// set to one degree as a default
+double AvoidSatellites::angular_distance = 1 * deg2rad;  /// set to one degree as a default
+unsigned int AvoidSatellites::timeStep = 10;
+double AvoidSatellites::cellSize = 2 * deg2rad;
+
+std::vector<std::vector<AvoidSatellites::Slice>> AvoidSatellites::index_;
+unsigned int AvoidSatellites::nAz_ = 0;
+unsigned int AvoidSatellites::nEl_ = 0;
+double AvoidSatellites::cell_ = 0;
+constexpr double AvoidSatellites::minElevation_;
+constexpr unsigned int AvoidSatellites::satBits_;
+
+
+namespace {
+/**
+ * @brief angular distance between two directions given in azimuth and elevation
+ * @author Matthias Schartner
+ */
+double angularDistance( double az1, double el1, double az2, double el2 ) noexcept {
+    double c = sin( el1 ) * sin( el2 ) + cos( el1 ) * cos( el2 ) * cos( az1 - az2 );
+    return acos( max( -1.0, min( 1.0, c ) ) );
+}
+
+/**
+ * @brief geodetic coordinates of station as required by SGP4
+ * @author Matthias Schartner
+ */
+CoordGeodetic geodetic( const Station &station ) noexcept {
+    const auto &pos = station.getPosition();
+    return CoordGeodetic( pos->getLat(), pos->getLon(), pos->getAltitude() / 1000., true );
+}
+}  // namespace
+
+
+void AvoidSatellites::initialize( const Network &network, unsigned int end ) noexcept {
+    index_.clear();
+    if ( satellitesToAvoid.empty() || angular_distance <= 0 || timeStep == 0 || !( cellSize > 0 ) ) {
+        return;
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+
+    unsigned long nsat = satellitesToAvoid.size();
+    if ( nsat >= ( 1ul << satBits_ ) ) {
+        nsat = ( 1ul << satBits_ ) - 1;
+#ifdef VIESCHEDPP_LOG
+        BOOST_LOG_TRIVIAL( warning ) << "only first " << nsat << " satellites are avoided";
+#else
+        cout << "[warning] only first " << nsat << " satellites are avoided\n";
+#endif
+    }
+
+    // cell index must fit into remaining key bits
+    cell_ = cellSize;
+    auto cells = [&]( double c ) {
+        return static_cast<unsigned long>( ceil( twopi / c ) ) *
+               static_cast<unsigned long>( ceil( ( halfpi - minElevation_ ) / c ) );
+    };
+    while ( cells( cell_ ) >= ( 1ul << ( 32 - satBits_ ) ) ) {
+        cell_ *= 1.25;
+    }
+    nAz_ = static_cast<unsigned int>( ceil( twopi / cell_ ) );
+    nEl_ = static_cast<unsigned int>( ceil( ( halfpi - minElevation_ ) / cell_ ) );
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule( dynamic ) if ( !omp_in_parallel() )
+#endif
+    for ( int i = 0; i < static_cast<int>( nsat ); ++i ) {
+        satellitesToAvoid[i]->precalcEphemeris( end );
+    }
+
+    unsigned long nsta = network.getNSta();
+    auto nSlices = static_cast<int>( end / timeStep + 2 );
+    vector<CoordGeodetic> geo;
+    for ( const auto &sta : network.getStations() ) {
+        geo.push_back( geodetic( sta ) );
+    }
+    index_ = vector<vector<Slice>>( nsta, vector<Slice>( nSlices ) );
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule( dynamic ) if ( !omp_in_parallel() )
+#endif
+    for ( int is = 0; is < nSlices; ++is ) {
+        auto time = static_cast<unsigned int>( is * timeStep );
+
+        // satellite positions are station independent
+        vector<Eci> eci;
+        vector<uint32_t> satIdx;
+        eci.reserve( nsat );
+        satIdx.reserve( nsat );
+        for ( unsigned long k = 0; k < nsat; ++k ) {
+            try {
+                eci.push_back( satellitesToAvoid[k]->getEci( time ) );
+                satIdx.push_back( static_cast<uint32_t>( k ) );
+            } catch ( ... ) {
+                // decayed satellites are ignored
+            }
+        }
+
+        for ( unsigned long ista = 0; ista < nsta; ++ista ) {
+            Observer obs( geo[ista] );
+            Slice &slice = index_[ista][is];
+            for ( unsigned long k = 0; k < eci.size(); ++k ) {
+                CoordTopocentric topo = obs.GetLookAngle( eci[k] );
+                if ( topo.elevation < minElevation_ ) {
+                    continue;
+                }
+                auto iel = min( nEl_ - 1, static_cast<unsigned int>( ( topo.elevation - minElevation_ ) / cell_ ) );
+                auto iaz = min( nAz_ - 1, static_cast<unsigned int>( topo.azimuth / cell_ ) );
+                uint32_t cell = iel * nAz_ + iaz;
+                slice.keys.push_back( ( cell << satBits_ ) | satIdx[k] );
+
+                // station velocity is below 0.5 km/s
+                double rate = ( eci[k].Velocity().Magnitude() + 0.5 ) / max( topo.range, 1.0 );
+                slice.maxRate = max( slice.maxRate, rate );
+            }
+            sort( slice.keys.begin(), slice.keys.end() );
+            slice.keys.shrink_to_fit();
+        }
+    }
+
+    unsigned long entries = 0;
+    for ( const auto &sta : index_ ) {
+        for ( const auto &slice : sta ) {
+            entries += slice.keys.size();
+        }
+    }
+    auto finish = std::chrono::high_resolution_clock::now();
+    auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>( finish - start );
+    string msg = ( boost::format( "satellite avoidance index: %d satellites, %d stations, %d time slices, %d entries "
+                                  "(%.1f MB) (%s)" ) %
+                   nsat % nsta % nSlices % entries % ( entries * sizeof( uint32_t ) / 1024. / 1024. ) %
+                   util::milliseconds2string( microseconds.count(), true ) )
+                     .str();
+#ifdef VIESCHEDPP_LOG
+    BOOST_LOG_TRIVIAL( info ) << msg;
+#else
+    cout << "[info] " << msg << "\n";
+#endif
+}
+
+
+bool AvoidSatellites::isTooClose( const Station &station, const std::shared_ptr<const AbstractSource> &source,
+                                  const PointingVector &start, const PointingVector &end ) noexcept {
+    if ( index_.empty() ) {
+        return false;
+    }
+    const vector<Slice> &slices = index_[station.getId()];
+
+    unsigned int t1 = start.getTime();
+    unsigned int t2 = max( t1, end.getTime() );
+    double duration = t2 - t1;
+    auto pointing = [&]( unsigned int t, double &az, double &el ) {
+        double f = duration > 0 ? ( t - t1 ) / duration : 0;
+        az = start.getAz() + f * ( end.getAz() - start.getAz() );
+        el = start.getEl() + f * ( end.getEl() - start.getEl() );
+        az = fmod( az, twopi );
+        if ( az < 0 ) {
+            az += twopi;
+        }
+    };
+
+    unique_ptr<Observer> obs;
+    for ( unsigned long is = t1 / timeStep; is < slices.size() && is * timeStep <= t2; ++is ) {
+        const Slice &slice = slices[is];
+        if ( slice.keys.empty() ) {
+            continue;
+        }
+        auto ta = max( t1, static_cast<unsigned int>( is * timeStep ) );
+        auto tb = min( t2, static_cast<unsigned int>( ( is + 1 ) * timeStep ) );
+        double azA, elA, azB, elB;
+        pointing( ta, azA, elA );
+        pointing( tb, azB, elB );
+
+        // search radius: distance + satellite motion within slice + pointing motion within slice
+        double radius = angular_distance + 1.5 * slice.maxRate * timeStep + angularDistance( azA, elA, azB, elB );
+        double el = elA;
+        double az = azA;
+
+        double elLow = max( minElevation_, el - radius );
+        double elHigh = min( halfpi, el + radius );
+        if ( elHigh < elLow ) {
+            continue;
+        }
+        auto iel0 = static_cast<unsigned int>( ( elLow - minElevation_ ) / cell_ );
+        auto iel1 = min( nEl_ - 1, static_cast<unsigned int>( ( elHigh - minElevation_ ) / cell_ ) );
+
+        // azimuth half width of spherical cap
+        double width = twopi;
+        if ( abs( el ) + radius < halfpi ) {
+            width = asin( min( 1.0, sin( radius ) / cos( el ) ) );
+        }
+
+        vector<uint32_t> candidates;
+        auto collect = [&]( uint32_t cell0, uint32_t cell1 ) {
+            auto first = lower_bound( slice.keys.begin(), slice.keys.end(), cell0 << satBits_ );
+            auto last = lower_bound( first, slice.keys.end(), ( cell1 + 1 ) << satBits_ );
+            for ( auto it = first; it != last; ++it ) {
+                candidates.push_back( *it & ( ( 1u << satBits_ ) - 1 ) );
+            }
+        };
+        for ( unsigned int iel = iel0; iel <= iel1; ++iel ) {
+            if ( width >= pi ) {
+                collect( iel * nAz_, iel * nAz_ + nAz_ - 1 );
+                continue;
+            }
+            auto iaz0 = static_cast<long>( floor( ( az - width ) / cell_ ) );
+            auto iaz1 = static_cast<long>( floor( ( az + width ) / cell_ ) );
+            if ( iaz0 < 0 ) {
+                collect( iel * nAz_ + static_cast<uint32_t>( iaz0 + nAz_ ), iel * nAz_ + nAz_ - 1 );
+                iaz0 = 0;
+            }
+            if ( iaz1 >= nAz_ ) {
+                collect( iel * nAz_, iel * nAz_ + static_cast<uint32_t>( iaz1 - nAz_ ) );
+                iaz1 = nAz_ - 1;
+            }
+            collect( iel * nAz_ + static_cast<uint32_t>( iaz0 ), iel * nAz_ + static_cast<uint32_t>( iaz1 ) );
+        }
+
+        // exact check of candidates
+        for ( uint32_t k : candidates ) {
+            const auto &sat = satellitesToAvoid[k];
+            if ( sat->getName() == source->getName() ) {
+                continue;
+            }
+            if ( obs == nullptr ) {
+                obs = make_unique<Observer>( geodetic( station ) );
+            }
+            for ( unsigned int t = ta; t <= tb; ++t ) {
+                try {
+                    CoordTopocentric topo = obs->GetLookAngle( sat->getEci( t ) );
+                    double azP, elP;
+                    pointing( t, azP, elP );
+                    if ( angularDistance( azP, elP, topo.azimuth, topo.elevation ) < angular_distance ) {
+                        return true;
+                    }
+                } catch ( ... ) {
+                    break;
+                }
+            }
+        }
+    }
+    return false;
+}
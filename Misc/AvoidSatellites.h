@@ -5,21 +5,87 @@
 #ifndef VIESCHEDPP_AVOIDSATELLITES_H
 #define VIESCHEDPP_AVOIDSATELLITES_H
 
+#include <cstdint>
+
+#include "../Scan/PointingVector.h"
 #include "../Source/Satellite.h"
+#include "../Station/Network.h"
 
 namespace VieVS {
 /**
  * @class AvoidSatellites
  * @brief list of satellites to be avoided during schedule generation
  *
+ * All satellites are propagated once on a time grid. For each station and time slice, the topocentric positions
+ * of all satellites above the horizon are binned into an azimuth/elevation grid (sorted cell/satellite keys).
+ * A check of a pointing direction only queries the cells around it and recomputes the exact distance for the few
+ * satellites found there.
+ *
  * @author Matthias Schartner
  * @date 22.07.2022
  */
 
 class AvoidSatellites {
    public:
-    static std::vector<std::shared_ptr<Satellite>> satellitesToAvoid;
-    static double angular_distance;
+    static std::vector<std::shared_ptr<Satellite>> satellitesToAvoid;  ///< list of satellites to be avoided
+    static double angular_distance;  ///< minimum angular distance between satellite and pointing direction in radians
+    static unsigned int timeStep;    ///< time between two index slices in seconds
+    static double cellSize;          ///< cell size of spatial index in radians
+
+
+    /**
+     * @brief propagate all satellites and build spatial index per station and time slice
+     * @author Matthias Schartner
+     *
+     * @param network station network
+     * @param end end time in seconds since session start
+     */
+    static void initialize( const Network &network, unsigned int end ) noexcept;
+
+
+    /**
+     * @brief check if spatial index was built
+     * @author Matthias Schartner
+     *
+     * @return true if satellites need to be avoided
+     */
+    static bool isActive() noexcept { return !index_.empty(); }
+
+
+    /**
+     * @brief check if a satellite comes too close to the pointing direction during an observation
+     * @author Matthias Schartner
+     *
+     * The pointing direction is linearly interpolated between start and end. Satellites are checked in steps of
+     * one second.
+     *
+     * @param station station
+     * @param source observed source (ignored if it is in the list of satellites to be avoided)
+     * @param start pointing vector at observation start
+     * @param end pointing vector at observation end
+     * @return true if a satellite is closer than angular_distance
+     */
+    static bool isTooClose( const Station &station, const std::shared_ptr<const AbstractSource> &source,
+                            const PointingVector &start, const PointingVector &end ) noexcept;
+
+
+   private:
+    static constexpr double minElevation_ = -10 * deg2rad;  ///< satellites below this elevation are not indexed
+    static constexpr unsigned int satBits_ = 18;            ///< number of bits of key used for satellite index
+
+    /**
+     * @brief spatial index of one station and time slice
+     * @author Matthias Schartner
+     */
+    struct Slice {
+        std::vector<uint32_t> keys;  ///< sorted keys (cell << satBits_ | satellite index)
+        double maxRate = 0;          ///< maximum angular velocity of indexed satellites in radians per second
+    };
+
+    static std::vector<std::vector<Slice>> index_;  ///< spatial index per station and time slice
+    static unsigned int nAz_;                       ///< number of azimuth cells
+    static unsigned int nEl_;                       ///< number of elevation cells
+    static double cell_;                            ///< used cell size in radians
 };
 }  // namespace VieVS
 
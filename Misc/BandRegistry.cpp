@@ -0,0 +1,39 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BandRegistry.h"
+
+
+using namespace std;
+using namespace VieVS;
+
+constexpr unsigned long BandRegistry::npos;
+vector<string> BandRegistry::names_;
+unordered_map<string, unsigned long> BandRegistry::name2id_;
+
+
+unsigned long BandRegistry::id( const std::string &name ) {
+    auto it = name2id_.find( name );
+    if ( it != name2id_.end() ) {
+        return it->second;
+    }
+    unsigned long newId = names_.size();
+    names_.push_back( name );
+    name2id_[name] = newId;
+    return newId;
+}
@@ -0,0 +1,223 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file BandRegistry.h
+ * @brief class BandRegistry and class template BandMap
+ *
+ * @author Matthias Schartner
+ * @date 15.10.2026
+ */
+
+#ifndef BANDREGISTRY_H
+#define BANDREGISTRY_H
+
+
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace VieVS {
+
+/**
+ * @class BandRegistry
+ * @brief interns band names into dense integer ids
+ *
+ * Band names are only compared during initialization. All per band information that is needed while scheduling
+ * (SEFD, flux density, minimum SNR, recording rate) is additionally stored in vectors indexed by the band id.
+ *
+ * New ids are only created during initialization (single threaded), afterwards the registry is read only.
+ *
+ * @author Matthias Schartner
+ * @date 15.10.2026
+ */
+class BandRegistry {
+   public:
+    static constexpr unsigned long npos = static_cast<unsigned long>( -1 );  ///< id of unknown bands
+
+
+    /**
+     * @brief get id of band, a new id is created if band is unknown
+     * @author Matthias Schartner
+     *
+     * @param name band name
+     * @return band id
+     */
+    static unsigned long id( const std::string &name );
+
+
+    /**
+     * @brief get id of band without creating a new id
+     * @author Matthias Schartner
+     *
+     * @param name band name
+     * @return band id or npos if band is unknown
+     */
+    static unsigned long find( const std::string &name ) noexcept {
+        auto it = name2id_.find( name );
+        return it == name2id_.end() ? npos : it->second;
+    }
+
+
+    /**
+     * @brief get band name
+     * @author Matthias Schartner
+     *
+     * @param id band id
+     * @return band name
+     */
+    static const std::string &name( unsigned long id ) { return names_.at( id ); }
+
+
+    /**
+     * @brief number of known bands
+     * @author Matthias Schartner
+     *
+     * @return number of known bands
+     */
+    static unsigned long size() noexcept { return names_.size(); }
+
+
+   private:
+    static std::vector<std::string> names_;                         ///< band name per id
+    static std::unordered_map<std::string, unsigned long> name2id_;  ///< band id per name
+};
+
+
+/**
+ * @class BandMap
+ * @brief per band values with dense lookup by band id
+ *
+ * Keeps the interface of a map with band names as keys (insertion, lookup and iteration by name) and adds a constant
+ * time lookup by band id without hashing strings.
+ *
+ * @author Matthias Schartner
+ * @date 15.10.2026
+ */
+template <typename T>
+class BandMap {
+   public:
+    using value_type = std::pair<std::string, T>;                             ///< band name and value
+    using const_iterator = typename std::vector<value_type>::const_iterator;  ///< iterator over all bands
+
+
+    /**
+     * @brief access value of band, a default value is inserted if band is missing
+     * @author Matthias Schartner
+     *
+     * @param band band name
+     * @return value of this band
+     */
+    T &operator[]( const std::string &band ) {
+        unsigned long bandId = BandRegistry::id( band );
+        if ( bandId < slot_.size() && slot_[bandId] != BandRegistry::npos ) {
+            return values_[slot_[bandId]].second;
+        }
+        if ( bandId >= slot_.size() ) {
+            slot_.resize( bandId + 1, BandRegistry::npos );
+        }
+        slot_[bandId] = values_.size();
+        values_.emplace_back( band, T() );
+        return values_.back().second;
+    }
+
+
+    /**
+     * @brief access value of band
+     * @author Matthias Schartner
+     *
+     * @param band band name
+     * @return value of this band
+     */
+    const T &at( const std::string &band ) const { return at( BandRegistry::find( band ) ); }
+
+
+    /**
+     * @brief access value of band
+     * @author Matthias Schartner
+     *
+     * @param bandId band id
+     * @return value of this band
+     */
+    const T &at( unsigned long bandId ) const {
+        if ( !contains( bandId ) ) {
+            throw std::out_of_range( "BandMap: band not found" );
+        }
+        return values_[slot_[bandId]].second;
+    }
+
+
+    /**
+     * @brief checks if value of band is available
+     * @author Matthias Schartner
+     *
+     * @param bandId band id
+     * @return true if value is available, otherwise false
+     */
+    bool contains( unsigned long bandId ) const noexcept {
+        return bandId < slot_.size() && slot_[bandId] != BandRegistry::npos;
+    }
+
+
+    /**
+     * @brief checks if there are no values
+     * @author Matthias Schartner
+     *
+     * @return true if there are no values, otherwise false
+     */
+    bool empty() const noexcept { return values_.empty(); }
+
+
+    /**
+     * @brief number of bands with values
+     * @author Matthias Schartner
+     *
+     * @return number of bands
+     */
+    unsigned long size() const noexcept { return values_.size(); }
+
+
+    /**
+     * @brief iterator to first band
+     * @author Matthias Schartner
+     *
+     * @return iterator to first band
+     */
+    const_iterator begin() const noexcept { return values_.begin(); }
+
+
+    /**
+     * @brief iterator behind last band
+     * @author Matthias Schartner
+     *
+     * @return iterator behind last band
+     */
+    const_iterator end() const noexcept { return values_.end(); }
+
+
+   private:
+    std::vector<value_type> values_;   ///< band name and value in insertion order
+    std::vector<unsigned long> slot_;  ///< index in values_ per band id or npos
+};
+
+}  // namespace VieVS
+
+#endif  // BANDREGISTRY_H
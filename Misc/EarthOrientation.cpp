@@ -0,0 +1,68 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EarthOrientation.h"
+
+
+using namespace std;
+using namespace VieVS;
+
+constexpr unsigned int EarthOrientation::cacheSize;
+
+
+const EarthOrientation::Epoch &EarthOrientation::get( unsigned int time ) noexcept {
+    static thread_local array<Epoch, cacheSize> cache;
+
+    Epoch &epoch = cache[time % cacheSize];
+    if ( !epoch.valid || epoch.time != time || epoch.mjdStart != TimeSystem::mjdStart ) {
+        calculate( time, epoch );
+    }
+    return epoch;
+}
+
+
+void EarthOrientation::calculate( unsigned int time, Epoch &epoch ) noexcept {
+    //  TIME
+    double date1 = 2400000.5;
+    double mjd = TimeSystem::mjdStart + static_cast<double>( time ) / 86400.0;
+
+    // Earth Rotation
+    double ERA = iauEra00( date1, mjd );
+
+    // precession nutation
+    double C[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+
+    unsigned int nut_precalc_idx = AstronomicalParameters::getNutInterpolationIdx( time );
+    double x = AstronomicalParameters::getNutX( time, nut_precalc_idx );
+    double y = AstronomicalParameters::getNutY( time, nut_precalc_idx );
+    double s = AstronomicalParameters::getNutS( time, nut_precalc_idx );
+
+    iauC2ixys( x, y, s, C );
+
+    //  Polar Motion
+    double W[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+    //  GCRS to ITRS
+    iauC2tcio( C, ERA, W, epoch.c2t );
+    iauTr( epoch.c2t, epoch.t2c );
+
+    epoch.gmst = TimeSystem::mjd2gmst( mjd );
+    epoch.mjd = mjd;
+    epoch.time = time;
+    epoch.mjdStart = TimeSystem::mjdStart;
+    epoch.valid = true;
+}
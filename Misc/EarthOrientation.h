@@ -0,0 +1,96 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file EarthOrientation.h
+ * @brief class EarthOrientation
+ *
+ * @author Matthias Schartner
+ * @date 15.10.2026
+ */
+
+#ifndef EARTHORIENTATION_H
+#define EARTHORIENTATION_H
+
+
+#include <array>
+
+#include "AstronomicalParameters.h"
+#include "TimeSystem.h"
+#include "sofa.h"
+
+
+namespace VieVS {
+
+/**
+ * @class EarthOrientation
+ * @brief station and source independent earth orientation per epoch
+ *
+ * The celestial to terrestrial rotation (including nutation from AstronomicalParameters) and the greenwich mean
+ * sidereal time only depend on time. They are calculated once per epoch and shared by all stations and sources.
+ *
+ * Each thread keeps a small direct mapped cache of recently used epochs, therefore no synchronization is required.
+ *
+ * @author Matthias Schartner
+ * @date 15.10.2026
+ */
+class EarthOrientation {
+   public:
+    /**
+     * @brief earth orientation of one epoch
+     * @author Matthias Schartner
+     */
+    struct Epoch {
+        double mjdStart = 0;    ///< session start used for calculation
+        unsigned int time = 0;  ///< time in seconds since session start
+        bool valid = false;     ///< flag if epoch was calculated
+        double mjd = 0;         ///< modified julian date
+        double c2t[3][3] = {};  ///< celestial to terrestrial rotation matrix
+        double t2c[3][3] = {};  ///< terrestrial to celestial rotation matrix
+        double gmst = 0;        ///< greenwich mean sidereal time
+    };
+
+
+    /**
+     * @brief get earth orientation of an epoch
+     * @author Matthias Schartner
+     *
+     * The reference is valid until the next call from the same thread.
+     *
+     * @param time time in seconds since session start
+     * @return earth orientation
+     */
+    static const Epoch &get( unsigned int time ) noexcept;
+
+
+   private:
+    static constexpr unsigned int cacheSize = 64;  ///< number of cached epochs per thread
+
+
+    /**
+     * @brief calculate earth orientation of an epoch
+     * @author Matthias Schartner
+     *
+     * @param time time in seconds since session start
+     * @param epoch calculated earth orientation
+     */
+    static void calculate( unsigned int time, Epoch &epoch ) noexcept;
+};
+}  // namespace VieVS
+
+#endif  // EARTHORIENTATION_H
@@ -0,0 +1,199 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ObjectCounter.h
+ * @brief thread safe object id and object counters
+ *
+ *
+ * @author Matthias Schartner
+ * @date 15.10.2026
+ */
+
+#ifndef OBJECTCOUNTER_H
+#define OBJECTCOUNTER_H
+
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+
+namespace VieVS {
+
+/**
+ * @class IdCounter
+ * @brief thread safe generator of object ids
+ *
+ * Ids are unique and increase monotonically within each thread. Only atomicity is required, therefore relaxed memory
+ * ordering is used.
+ *
+ * @author Matthias Schartner
+ * @date 15.10.2026
+ */
+class IdCounter {
+   public:
+    /**
+     * @brief constructor
+     * @author Matthias Schartner
+     *
+     * @param start first id
+     */
+    explicit IdCounter( unsigned long start = 0 ) noexcept : next_{ start } {}
+
+
+    /**
+     * @brief get next id
+     * @author Matthias Schartner
+     *
+     * @return next id
+     */
+    unsigned long next() noexcept { return next_.fetch_add( 1, std::memory_order_relaxed ); }
+
+
+    /**
+     * @brief get number of generated ids (including start value)
+     * @author Matthias Schartner
+     *
+     * @return next id which will be generated
+     */
+    unsigned long get() const noexcept { return next_.load( std::memory_order_relaxed ); }
+
+
+   private:
+    std::atomic<unsigned long> next_;  ///< next id
+};
+
+
+/**
+ * @class ThreadLocalCounter
+ * @brief object counter without shared state during counting
+ *
+ * Each thread counts in its own slot (on its own cache line). The total is the sum of all slots plus the counts of
+ * already finished threads. Used for value types which do not need an unique id.
+ *
+ * @tparam T counted type
+ *
+ * @author Matthias Schartner
+ * @date 15.10.2026
+ */
+template <typename T>
+class ThreadLocalCounter {
+   public:
+    /**
+     * @brief count one object in the slot of this thread
+     * @author Matthias Schartner
+     */
+    static void increment() noexcept {
+        Slot &s = slot();
+        s.count.store( s.count.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+    }
+
+
+    /**
+     * @brief total number of counted objects of all threads
+     * @author Matthias Schartner
+     *
+     * @return total number of counted objects
+     */
+    static unsigned long get() noexcept {
+        std::lock_guard<std::mutex> lock( mutex() );
+        unsigned long sum = finished();
+        for ( const Slot *any : slots() ) {
+            sum += any->count.load( std::memory_order_relaxed );
+        }
+        return sum;
+    }
+
+
+   private:
+    /**
+     * @brief counter of one thread
+     * @author Matthias Schartner
+     */
+    struct alignas( 64 ) Slot {
+        std::atomic<unsigned long> count{ 0 };  ///< number of counted objects
+
+        /**
+         * @brief register slot
+         * @author Matthias Schartner
+         */
+        Slot() {
+            std::lock_guard<std::mutex> lock( mutex() );
+            slots().push_back( this );
+        }
+
+        /**
+         * @brief unregister slot and keep its count
+         * @author Matthias Schartner
+         */
+        ~Slot() {
+            std::lock_guard<std::mutex> lock( mutex() );
+            finished() += count.load( std::memory_order_relaxed );
+            slots().erase( std::remove( slots().begin(), slots().end(), this ), slots().end() );
+        }
+    };
+
+    /**
+     * @brief slot of this thread
+     * @author Matthias Schartner
+     *
+     * @return slot of this thread
+     */
+    static Slot &slot() noexcept {
+        static thread_local Slot s;
+        return s;
+    }
+
+    /**
+     * @brief mutex which guards slot registration
+     * @author Matthias Schartner
+     *
+     * @return mutex
+     */
+    static std::mutex &mutex() noexcept {
+        static std::mutex m;
+        return m;
+    }
+
+    /**
+     * @brief all registered slots
+     * @author Matthias Schartner
+     *
+     * @return registered slots
+     */
+    static std::vector<Slot *> &slots() noexcept {
+        static std::vector<Slot *> s;
+        return s;
+    }
+
+    /**
+     * @brief counts of finished threads
+     * @author Matthias Schartner
+     *
+     * @return counts of finished threads
+     */
+    static unsigned long &finished() noexcept {
+        static unsigned long n = 0;
+        return n;
+    }
+};
+}  // namespace VieVS
+
+#endif  // OBJECTCOUNTER_H
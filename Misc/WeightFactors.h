@@ -72,6 +72,73 @@ class WeightFactors {
     ///< (everything below has factor 1)
 
 
+    /**
+     * @brief copy of all thread local weight factors
+     * @author Matthias Schartner
+     *
+     * weight factors are thread local (one set per multi scheduling version). This struct is used to hand over the
+     * weight factors of the scheduling thread to OpenMP worker threads during scan selection.
+     */
+    struct Values {
+        double weightSkyCoverage;           ///< weight factor for sky Coverage
+        double weightNumberOfObservations;  ///< weight factor for number of observations
+        double weightDuration;              ///< weight factor for duration
+        double weightAverageSources;        ///< weight factor for average out sources
+        double weightAverageStations;       ///< weight factor for average out stations
+        double weightAverageBaselines;      ///< weight factor for average out baselines
+        double weightIdleTime;              ///< weight factor for extra weight after long idle time
+        unsigned int idleTimeInterval;      ///< long idle time interval
+        double weightClosures;              ///< weight factor for closure delays
+        unsigned int maxClosures;           ///< maximum number of closure delays
+        double weightDeclination;           ///< weight factor for declination
+        double declinationStartWeight;      ///< start declination of additional weight
+        double declinationFullWeight;       ///< end declination of additional declination weight slope
+        double weightLowElevation;          ///< weight factor for low elevation scans
+        double lowElevationStartWeight;     ///< start elevation of additional weight
+        double lowElevationFullWeight;      ///< end elevation of additional declination weight slope
+    };
+
+
+    /**
+     * @brief get weight factors of calling thread
+     * @author Matthias Schartner
+     *
+     * @return copy of all weight factors
+     */
+    static Values get() noexcept {
+        return {weightSkyCoverage,      weightNumberOfObservations, weightDuration,          weightAverageSources,
+                weightAverageStations,  weightAverageBaselines,     weightIdleTime,          idleTimeInterval,
+                weightClosures,         maxClosures,                weightDeclination,       declinationStartWeight,
+                declinationFullWeight,  weightLowElevation,         lowElevationStartWeight, lowElevationFullWeight};
+    }
+
+
+    /**
+     * @brief set weight factors of calling thread
+     * @author Matthias Schartner
+     *
+     * @param v weight factors
+     */
+    static void set( const Values &v ) noexcept {
+        weightSkyCoverage = v.weightSkyCoverage;
+        weightNumberOfObservations = v.weightNumberOfObservations;
+        weightDuration = v.weightDuration;
+        weightAverageSources = v.weightAverageSources;
+        weightAverageStations = v.weightAverageStations;
+        weightAverageBaselines = v.weightAverageBaselines;
+        weightIdleTime = v.weightIdleTime;
+        idleTimeInterval = v.idleTimeInterval;
+        weightClosures = v.weightClosures;
+        maxClosures = v.maxClosures;
+        weightDeclination = v.weightDeclination;
+        declinationStartWeight = v.declinationStartWeight;
+        declinationFullWeight = v.declinationFullWeight;
+        weightLowElevation = v.weightLowElevation;
+        lowElevationStartWeight = v.lowElevationStartWeight;
+        lowElevationFullWeight = v.lowElevationFullWeight;
+    }
+
+
     /**
      * @brief summary of all weight factors
      * @author Matthias Schartner
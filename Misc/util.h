@@ -37,6 +37,7 @@
 #include <boost/property_tree/ptree.hpp>
 #include <cmath>
 #include <numeric>
+#include <utility>
 #include <vector>
 
 #include "Constants.h"
@@ -381,6 +382,23 @@ std::string milliseconds2string( long long int usec, bool forceSeconds = false )
  */
 std::string version2prefix(int version);
 
+/**
+ * @brief index of station pair in dense triangular lookup tables
+ * @author Matthias Schartner
+ *
+ * order of station ids does not matter, the two station ids must differ
+ *
+ * @param staid1 station id 1
+ * @param staid2 station id 2
+ * @return index of station pair
+ */
+inline unsigned long pairIndex( unsigned long staid1, unsigned long staid2 ) noexcept {
+    if ( staid1 > staid2 ) {
+        std::swap( staid1, staid2 );
+    }
+    return staid2 * ( staid2 - 1 ) / 2 + staid1;
+}
+
 
 }  // namespace util
 }  // namespace VieVS
@@ -26,7 +26,10 @@ using namespace std;
 unsigned long VieVS::Mode::nextId = 0;
 
 
-Mode::Mode( std::string name, unsigned long nsta ) : VieVS_NamedObject{ std::move( name ), nextId++ }, nsta_{ nsta } {}
+Mode::Mode( std::string name, unsigned long nsta )
+    : VieVS_NamedObject{ std::move( name ), nextId++ },
+      nsta_{ nsta },
+      staids2efficiency_( nsta * ( nsta - 1 ) / 2, 0 ) {}
 
 
 boost::property_tree::ptree Mode::toPropertytree( const std::vector<std::string> &stations ) const {
@@ -118,8 +121,13 @@ void Mode::calcRecordingRates() {
 
             auto overlappingFrequencies = freq1.get()->observingRate( freq2.get(), bitsPerChannel );
 
-            staids2efficiency_[{ staid1, staid2 }] = efficiency;
-            staids2recordingRate_[{ staid1, staid2 }] = overlappingFrequencies;
+            staids2efficiency_[util::pairIndex( staid1, staid2 )] = efficiency;
+            for ( unsigned long i = 0; i < nBandSlots_; ++i ) {
+                staids2recordingRate_[util::pairIndex( staid1, staid2 ) * nBandSlots_ + i] = 0;
+            }
+            for ( const auto &any : overlappingFrequencies ) {
+                setRecordingRate( staid1, staid2, any.first, any.second );
+            }
         }
     }
 }
@@ -135,16 +143,35 @@ void Mode::setRecordingRates( const std::string &band, double recRate ) {
         }
         // update recording rate for this baseline and band
         for ( unsigned long staid2 = staid1 + 1; staid2 < nsta_; ++staid2 ) {
-            staids2recordingRate_[{ staid1, staid2 }][band] = recRate;
+            setRecordingRate( staid1, staid2, band, recRate );
+        }
+    }
+}
+
+
+void Mode::setRecordingRate( unsigned long staid1, unsigned long staid2, const std::string &band, double recRate ) {
+    unsigned long bandId = BandRegistry::id( band );
+    if ( bandId >= nBandSlots_ ) {
+        // increase number of band ids per station pair and move existing recording rates
+        unsigned long nPairs = nsta_ * ( nsta_ - 1 ) / 2;
+        unsigned long nSlots = bandId + 1;
+        vector<double> rates( nPairs * nSlots, 0 );
+        for ( unsigned long i = 0; i < nPairs; ++i ) {
+            for ( unsigned long j = 0; j < nBandSlots_; ++j ) {
+                rates[i * nSlots + j] = staids2recordingRate_[i * nBandSlots_ + j];
+            }
         }
+        staids2recordingRate_ = move( rates );
+        nBandSlots_ = nSlots;
     }
+    staids2recordingRate_[util::pairIndex( staid1, staid2 ) * nBandSlots_ + bandId] = recRate;
 }
 
 
 void Mode::setEfficiencyFactor( double eff ) {
     for ( unsigned long staid1 = 0; staid1 < nsta_; ++staid1 ) {
         for ( unsigned long staid2 = staid1 + 1; staid2 < nsta_; ++staid2 ) {
-            staids2efficiency_[{ staid1, staid2 }] = eff;
+            staids2efficiency_[util::pairIndex( staid1, staid2 )] = eff;
         }
     }
 }
@@ -357,22 +384,22 @@ void Mode::operationNotesSummary( std::ofstream &of, const std::vector<std::stri
 
 
 double Mode::recordingRate( unsigned long staid1, unsigned long staid2, const std::string &band ) const {
-    if ( staid1 > staid2 ) {
-        swap( staid1, staid2 );
-    }
-    auto it = staids2recordingRate_.find( { staid1, staid2 } );
-    // if station id combination is not saved in map return 0
-    if ( it == staids2recordingRate_.end() ) {
+    // check if band exists
+    unsigned long bandId = BandRegistry::find( band );
+    if ( bandId == BandRegistry::npos ) {
         return 0;
     }
+    return recordingRate( staid1, staid2, bandId );
+}
 
-    // check if band exists
-    auto it2 = it->second.find( band );
-    if ( it2 == it->second.end() ) {
+
+double Mode::recordingRate( unsigned long staid1, unsigned long staid2, unsigned long bandId ) const {
+    // if station id combination or band is not part of this mode return 0
+    if ( staid1 >= nsta_ || staid2 >= nsta_ || staid1 == staid2 || bandId >= nBandSlots_ ) {
         return 0;
     }
 
-    return it2->second;
+    return staids2recordingRate_[util::pairIndex( staid1, staid2 ) * nBandSlots_ + bandId];
 }
 
 
@@ -651,16 +678,12 @@ void Mode::changeFreq( int idx, unsigned long staid ) {
 
 
 double Mode::efficiency( unsigned long staid1, unsigned long staid2 ) const {
-    if ( staid1 > staid2 ) {
-        swap( staid1, staid2 );
-    }
-    auto it = staids2efficiency_.find( { staid1, staid2 } );
-    // if station id combination is not saved in map return 0
-    if ( it == staids2efficiency_.end() ) {
+    // if station id combination is not part of this mode return 0
+    if ( staid1 >= nsta_ || staid2 >= nsta_ || staid1 == staid2 ) {
         return 0;
     }
 
-    return it->second;
+    return staids2efficiency_[util::pairIndex( staid1, staid2 )];
 }
 
 
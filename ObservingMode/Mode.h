@@ -35,6 +35,7 @@
 #include <utility>
 
 #include "../Input/SkdCatalogReader.h"
+#include "../Misc/BandRegistry.h"
 #include "../Misc/VieVS_NamedObject.h"
 #include "Bbc.h"
 #include "Freq.h"
@@ -110,6 +111,7 @@ class Mode : public VieVS_NamedObject {
         freqs_.emplace_back( newFreq, staids );
         const auto &tmp = newFreq->getBands();
         bands_.insert( tmp.begin(), tmp.end() );
+        updateBandIds();
     }
 
 
@@ -170,7 +172,10 @@ class Mode : public VieVS_NamedObject {
      *
      * @param bands list of all bands
      */
-    void setBands( const std::set<std::string> &bands ) { bands_ = bands; }
+    void setBands( const std::set<std::string> &bands ) {
+        bands_ = bands;
+        updateBandIds();
+    }
 
 
     /**
@@ -185,6 +190,18 @@ class Mode : public VieVS_NamedObject {
     double recordingRate( unsigned long staid1, unsigned long staid2, const std::string &band ) const;
 
 
+    /**
+     * @brief recording rate for observation
+     * @author Matthias Schartner
+     *
+     * @param staid1 station 1
+     * @param staid2 station 2
+     * @param bandId observed band id
+     * @return recording rate
+     */
+    double recordingRate( unsigned long staid1, unsigned long staid2, unsigned long bandId ) const;
+
+
     /**
      * @brief efficiency factor between stations
      * @author Matthias Schartner
@@ -366,6 +383,17 @@ class Mode : public VieVS_NamedObject {
     const std::set<std::string> &getAllBands() const { return bands_; }
 
 
+    /**
+     * @brief get list of all band ids
+     * @author Matthias Schartner
+     *
+     * same order as getAllBands()
+     *
+     * @return list of all band ids
+     */
+    const std::vector<unsigned long> &getAllBandIds() const { return bandIds_; }
+
+
     /**
      * @brief getter for number of stations
      * @author Matthias Schartner
@@ -511,16 +539,38 @@ class Mode : public VieVS_NamedObject {
     std::vector<std::pair<std::shared_ptr<const std::string>, std::vector<unsigned long>>>
         track_frame_formats_;  ///< all track frame format blocks with corresponding station ids
 
-    std::unordered_map<std::pair<unsigned long, unsigned long>, std::unordered_map<std::string, double>,
-                       boost::hash<std::pair<unsigned long, unsigned long>>>
-        staids2recordingRate_;  ///< recording rate per station ids and band
-    std::unordered_map<std::pair<unsigned long, unsigned long>, double,
-                       boost::hash<std::pair<unsigned long, unsigned long>>>
-        staids2efficiency_;  ///< efficiency per station ids
+    unsigned long nBandSlots_ = 0;              ///< number of band ids per station pair in staids2recordingRate_
+    std::vector<double> staids2recordingRate_;  ///< recording rate per station pair (see util::pairIndex) and band id
+    std::vector<double> staids2efficiency_;     ///< efficiency per station pair (see util::pairIndex)
 
     std::unordered_map<unsigned long, double> staid2totalRecordingRate_;  ///< total recording rate per station id
 
-    std::set<std::string> bands_;  ///< list of all bands
+    std::set<std::string> bands_;          ///< list of all bands
+    std::vector<unsigned long> bandIds_;  ///< list of all band ids
+
+
+    /**
+     * @brief update list of band ids based on list of bands
+     * @author Matthias Schartner
+     */
+    void updateBandIds() {
+        bandIds_.clear();
+        for ( const auto &band : bands_ ) {
+            bandIds_.push_back( BandRegistry::id( band ) );
+        }
+    }
+
+
+    /**
+     * @brief set recording rate of one baseline and band
+     * @author Matthias Schartner
+     *
+     * @param staid1 station 1 (staid1 < staid2)
+     * @param staid2 station 2
+     * @param band band name
+     * @param recRate recording rate
+     */
+    void setRecordingRate( unsigned long staid1, unsigned long staid2, const std::string &band, double recRate );
 
     /**
      * @brief station ids to property tree
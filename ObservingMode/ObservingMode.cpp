@@ -30,6 +30,9 @@ std::unordered_map<std::string, VieVS::ObservingMode::Backup>
     VieVS::ObservingMode::sourceBackup;                                           ///< backup version for source
 std::unordered_map<std::string, double> VieVS::ObservingMode::sourceBackupValue;  ///< backup value for source
 
+std::vector<char> VieVS::ObservingMode::sourceBackupInternalModelById_;
+std::vector<double> VieVS::ObservingMode::wavelengthById_;
+
 ObservingMode::ObservingMode() : VieVS_Object( nextId++ ) {}
 
 
@@ -199,6 +202,28 @@ void ObservingMode::simpleMode( unsigned long nsta, double samplerate, unsigned
 }
 
 
+void ObservingMode::indexBands() noexcept {
+    for ( const auto &any : sourceBackup ) {
+        BandRegistry::id( any.first );
+    }
+    for ( const auto &any : wavelengths ) {
+        BandRegistry::id( any.first );
+    }
+
+    unsigned long nBands = BandRegistry::size();
+    sourceBackupInternalModelById_.assign( nBands, 0 );
+    wavelengthById_.assign( nBands, numeric_limits<double>::quiet_NaN() );
+    for ( unsigned long bandId = 0; bandId < nBands; ++bandId ) {
+        const string &band = BandRegistry::name( bandId );
+        sourceBackupInternalModelById_[bandId] = sourceBackupIsInternalModel( band );
+        auto it = wavelengths.find( band );
+        if ( it != wavelengths.end() ) {
+            wavelengthById_[bandId] = it->second;
+        }
+    }
+}
+
+
 boost::property_tree::ptree ObservingMode::toPropertytree() const {
     boost::property_tree::ptree p;
     for ( const auto &any : freqs_ ) {
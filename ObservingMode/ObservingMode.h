@@ -20,6 +20,10 @@
 #define VIESCHEDPP_OBSMODES_H
 
 
+#include <cmath>
+#include <limits>
+
+#include "../Misc/BandRegistry.h"
 #include "Mode.h"
 
 /**
@@ -88,6 +92,61 @@ class ObservingMode : public VieVS_Object {
     static std::set<std::string> bands;                          ///< list of all observed bands
     static std::unordered_map<std::string, double> wavelengths;  ///< backup wavelength for commonly used bands
 
+
+    /**
+     * @brief check if internal flux model is used as source backup for this band
+     * @author Matthias Schartner
+     *
+     * Read-only lookup (no insertion into static map), safe to call from multiple threads during scan selection.
+     *
+     * @param band band name
+     * @return true if internal flux model is used as backup
+     */
+    static bool sourceBackupIsInternalModel( const std::string &band ) noexcept {
+        auto it = sourceBackup.find( band );
+        return it != sourceBackup.end() && it->second == Backup::internalModel;
+    }
+
+    /**
+     * @brief check if internal flux model is used as source backup for this band
+     * @author Matthias Schartner
+     *
+     * Uses the dense lookup created by indexBands(), bands unknown at that time fall back to the band name lookup.
+     *
+     * @param bandId band id
+     * @return true if internal flux model is used as backup
+     */
+    static bool sourceBackupIsInternalModel( unsigned long bandId ) noexcept {
+        if ( bandId < sourceBackupInternalModelById_.size() ) {
+            return sourceBackupInternalModelById_[bandId] != 0;
+        }
+        return sourceBackupIsInternalModel( BandRegistry::name( bandId ) );
+    }
+
+    /**
+     * @brief backup wavelength of band
+     * @author Matthias Schartner
+     *
+     * Uses the dense lookup created by indexBands(), bands unknown at that time fall back to the band name lookup.
+     *
+     * @param bandId band id
+     * @return backup wavelength
+     */
+    static double wavelength( unsigned long bandId ) {
+        if ( bandId < wavelengthById_.size() && !std::isnan( wavelengthById_[bandId] ) ) {
+            return wavelengthById_[bandId];
+        }
+        return wavelengths.at( BandRegistry::name( bandId ) );
+    }
+
+    /**
+     * @brief create dense per band id lookups of source backup models and wavelengths
+     * @author Matthias Schartner
+     *
+     * Has to be called once all band policies and wavelengths are set and before scheduling starts.
+     */
+    static void indexBands() noexcept;
+
     /**
      * @brief constructor
      * @author Matthias Schartner
@@ -467,8 +526,10 @@ class ObservingMode : public VieVS_Object {
 
 
    private:
-    static unsigned long nextId;             ///< next id for this object type
-    std::vector<std::string> stationNames_;  ///< station names
+    static unsigned long nextId;                              ///< next id for this object type
+    static std::vector<char> sourceBackupInternalModelById_;  ///< internal flux model as source backup per band id
+    static std::vector<double> wavelengthById_;               ///< backup wavelength per band id (NaN if unknown)
+    std::vector<std::string> stationNames_;                   ///< station names
 
     std::vector<std::shared_ptr<const Mode>> modes_;                     ///< list of all MODE blocks
     std::vector<std::shared_ptr<const If>> ifs_;                         ///< list of all IF blocks
@@ -105,6 +105,25 @@ void Output::writeVex() {
 }
 
 void Output::writeVexSatelliteTracking() {
+    // propagate satellites once for all stations
+    unsigned int delta = xml_.get( "VieSchedpp.output.createVEX_satelliteTracking_deltaT", 10 );
+    vector<shared_ptr<const Satellite>> satellites;
+    vector<vector<unsigned int>> times;
+    for ( const auto &sat : sourceList_.getSatellites() ) {
+        if ( sat->getNTotalScans() == 0 ) {
+            continue;
+        }
+        satellites.push_back( sat );
+        times.push_back( Vex::trackingTimes( scans_, *sat, delta ) );
+    }
+    auto states = Satellite::propagate( satellites, times );
+    unordered_map<unsigned long, vector<Eci>> satelliteStates;
+    for ( unsigned long i = 0; i < satellites.size(); ++i ) {
+        if ( states[i].size() == times[i].size() ) {
+            satelliteStates.emplace( satellites[i]->getId(), std::move( states[i] ) );
+        }
+    }
+
     for ( const auto &sta : network_.getStations() ) {
         string fileName = getName();
         fileName.append( "_" ).append( sta.getAlternativeName() ).append( ".vex" );
@@ -114,7 +133,7 @@ void Output::writeVexSatelliteTracking() {
         cout << "[info] writing vex file to: " << fileName;
 #endif
         Vex vex( path_ + fileName );
-        vex.writeVexTracking( network_, sourceList_, scans_, obsModes_, xml_, sta.getPosition() );
+        vex.writeVexTracking( network_, sourceList_, scans_, obsModes_, xml_, sta.getPosition(), satelliteStates );
     }
 
     string fileName = getName();
@@ -127,7 +146,7 @@ void Output::writeVexSatelliteTracking() {
     shared_ptr<const Position> geo = make_shared<const Position>( Position( 0, 0, 0 ) );
 
     Vex vex( path_ + fileName );
-    vex.writeVexTracking( network_, sourceList_, scans_, obsModes_, xml_, geo );
+    vex.writeVexTracking( network_, sourceList_, scans_, obsModes_, xml_, geo, satelliteStates );
 }
 
 
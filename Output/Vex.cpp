@@ -58,7 +58,8 @@ void Vex::writeVex( const Network &network, const SourceList &sourceList, const
 
 void Vex::writeVexTracking( const Network &network, const SourceList &sourceList, const vector<Scan> &scans,
                             const shared_ptr<const ObservingMode> &obsModes, const boost::property_tree::ptree &xml,
-                            const std::shared_ptr<const Position> &pos ) {
+                            const std::shared_ptr<const Position> &pos,
+                            const std::unordered_map<unsigned long, std::vector<Eci>> &satelliteStates ) {
     global_block( xml.get( "VieSchedpp.general.experimentName", "schedule" ) );
     unsigned int delta = xml.get( "VieSchedpp.output.createVEX_satelliteTracking_deltaT", 10 );
 
@@ -72,7 +73,7 @@ void Vex::writeVexTracking( const Network &network, const SourceList &sourceList
     antenna_block( network.getStations() );
     das_block( network.getStations() );
 
-    sourceBlockTracking( scans, sourceList, pos, delta );
+    sourceBlockTracking( scans, sourceList, pos, delta, satelliteStates );
 
     bbc_block( obsModes );
     if_block( obsModes );
@@ -530,7 +531,8 @@ void Vex::roll_block() {
 }
 
 void VieVS::Vex::sourceBlockTracking( const std::vector<Scan> &scans, const SourceList &sourceList,
-                                      const std::shared_ptr<const Position> &pos, unsigned int delta ) {
+                                      const std::shared_ptr<const Position> &pos, unsigned int delta,
+                                      const std::unordered_map<unsigned long, std::vector<Eci>> &satelliteStates ) {
     of << "*========================================================================================================="
           "\n";
     of << "$SOURCE;\n";
@@ -541,18 +543,31 @@ void VieVS::Vex::sourceBlockTracking( const std::vector<Scan> &scans, const Sour
             continue;
         }
 
-        vector<unsigned int> times;
-        for ( const auto &scan : scans ) {
-            if ( any->hasId( scan.getSourceId() ) ) {
-                for ( unsigned int i = scan.getTimes().getObservingTime();
-                      i < scan.getTimes().getObservingTime( Timestamp::end ); i += delta ) {
-                    times.push_back( i );
-                }
-            }
+        vector<unsigned int> times = trackingTimes( scans, *any, delta );
+
+        auto states = satelliteStates.find( any->getId() );
+        auto sat = dynamic_pointer_cast<const Satellite>( any );
+        if ( sat != nullptr && states != satelliteStates.end() && states->second.size() == times.size() ) {
+            sat->toVex( of, times, states->second, pos );
+        } else {
+            any->toVex( of, times, pos );
         }
+    }
+}
+
 
-        any->toVex( of, times, pos );
+std::vector<unsigned int> VieVS::Vex::trackingTimes( const std::vector<Scan> &scans, const AbstractSource &source,
+                                                     unsigned int delta ) {
+    vector<unsigned int> times;
+    for ( const auto &scan : scans ) {
+        if ( source.hasId( scan.getSourceId() ) ) {
+            for ( unsigned int i = scan.getTimes().getObservingTime();
+                  i < scan.getTimes().getObservingTime( Timestamp::end ); i += delta ) {
+                times.push_back( i );
+            }
+        }
     }
+    return times;
 }
 
 
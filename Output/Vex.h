@@ -80,10 +80,26 @@ class Vex : public VieVS_Object {
      *
      *
      * @param xml paramters.xml file
+     * @param pos observer position
+     * @param satelliteStates precalculated satellite states per source id (see trackingTimes())
      */
     void writeVexTracking( const Network &network, const SourceList &sourceList, const std::vector<Scan> &scans,
                            const std::shared_ptr<const ObservingMode> &obsModes, const boost::property_tree::ptree &xml,
-                           const std::shared_ptr<const Position> &pos );
+                           const std::shared_ptr<const Position> &pos,
+                           const std::unordered_map<unsigned long, std::vector<Eci>> &satelliteStates = {} );
+
+
+    /**
+     * @brief tracking times of a source
+     * @author Matthias Schartner
+     *
+     * @param scans list of all scans
+     * @param source source
+     * @param delta delta time between tracking intervals
+     * @return tracking times
+     */
+    static std::vector<unsigned int> trackingTimes( const std::vector<Scan> &scans, const AbstractSource &source,
+                                                    unsigned int delta );
 
     /**
      * @brief write vex $SOURCE block with satellite tracking
@@ -93,9 +109,11 @@ class Vex : public VieVS_Object {
      * @param sourceList list of all sources
      * @param pos observer position
      * @param delta delta time between tracking intervals
+     * @param satelliteStates precalculated satellite states per source id
      */
     void sourceBlockTracking( const std::vector<Scan> &scans, const SourceList &sourceList,
-                              const std::shared_ptr<const Position> &pos, unsigned int delta );
+                              const std::shared_ptr<const Position> &pos, unsigned int delta,
+                              const std::unordered_map<unsigned long, std::vector<Eci>> &satelliteStates );
 
 
     /**
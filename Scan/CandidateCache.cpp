@@ -0,0 +1,106 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CandidateCache.h"
+
+
+using namespace std;
+using namespace VieVS;
+
+
+void CandidateCache::resize( unsigned long nsta, unsigned long nsrc ) {
+    if ( nsta == nsta_ && nsrc == nsrc_ ) {
+        return;
+    }
+    nsta_ = nsta;
+    nsrc_ = nsrc;
+    entries_.assign( nsta * nsrc, Entry() );
+}
+
+
+void CandidateCache::calcAzEl( const Station &station, const std::shared_ptr<const AbstractSource> &source,
+                               PointingVector &p ) noexcept {
+    Entry &entry = entries_[station.getId() * nsrc_ + source->getId()];
+
+    bool hit = entry.time == p.getTime();
+    if ( !hit ) {
+        station.calcAzEl_simple( source, p );
+        entry.time = p.getTime();
+        entry.az = p.getAz();
+        entry.el = p.getEl();
+        entry.ha = p.getHa();
+        entry.dc = p.getDc();
+    } else {
+        p.setAz( entry.az );
+        p.setEl( entry.el );
+        p.setHa( entry.ha );
+        p.setDc( entry.dc );
+    }
+    count( hit );
+}
+
+
+bool CandidateCache::isVisible( const Station &station, const PointingVector &p, double minElevationSource ) noexcept {
+    Entry &entry = entries_[station.getId() * nsrc_ + p.getSrcid()];
+
+    bool hit = entry.visibleTime == p.getTime() && entry.visibleRevision == station.getRevision() &&
+               entry.visibleMinElevation == minElevationSource;
+    if ( !hit ) {
+        entry.visibleTime = p.getTime();
+        entry.visibleRevision = station.getRevision();
+        entry.visibleMinElevation = minElevationSource;
+        entry.visible = station.isVisible( p, minElevationSource );
+    }
+    count( hit );
+    return entry.visible;
+}
+
+
+boost::optional<unsigned int> CandidateCache::unwrapAndSlewTime( const Station &station, PointingVector &p ) noexcept {
+    Entry &entry = entries_[station.getId() * nsrc_ + p.getSrcid()];
+
+    bool hit = entry.revision == station.getRevision() && entry.targetAz == p.getAz() && entry.targetEl == p.getEl();
+    if ( !hit ) {
+        entry.revision = station.getRevision();
+        entry.targetAz = p.getAz();
+        entry.targetEl = p.getEl();
+
+        station.getCableWrap().calcUnwrappedAz( station.getCurrentPointingVector(), p );
+        entry.unwrappedAz = p.getAz();
+        entry.slewTime = station.slewTime( p );
+    } else {
+        p.setAz( entry.unwrappedAz );
+    }
+    count( hit );
+    return entry.slewTime;
+}
+
+
+void CandidateCache::count( bool hit ) noexcept {
+    if ( hit ) {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++hits_;
+    } else {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++misses_;
+    }
+}
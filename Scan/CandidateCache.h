@@ -0,0 +1,180 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file CandidateCache.h
+ * @brief class CandidateCache
+ *
+ * @author Matthias Schartner
+ * @date 15.10.2026
+ */
+
+#ifndef CANDIDATECACHE_H
+#define CANDIDATECACHE_H
+
+
+#include <boost/optional.hpp>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "../Source/AbstractSource.h"
+#include "../Station/Station.h"
+#include "PointingVector.h"
+
+
+namespace VieVS {
+
+/**
+ * @class CandidateCache
+ * @brief per station and source partial results which are reused between consecutive scan selections
+ *
+ * Each scan selection creates a new subcon for all sources. Most stations did not move since the previous scan
+ * selection, therefore the pointing vector at the earliest possible scan start and the corresponding slew time of
+ * these stations are unchanged. This class stores these partial results for every station/source pair.
+ *
+ * Azimuth and elevation only depend on the time and are reused if the time matches. Visibility additionally depends
+ * on the station state and on the minimum elevation of the source. Unwrapped azimuth and slew time depend on the
+ * station state and are reused if the slew target and the station revision match (see
+ * Station::getRevision()). The revision changes if the station was part of the last scan (Station::update), if
+ * parameters changed or if the current pointing vector was set, all other entries remain valid.
+ *
+ * Entries of different sources are independent, thus subcons with one scan per source can access the cache from
+ * multiple threads.
+ *
+ * @author Matthias Schartner
+ * @date 15.10.2026
+ */
+class CandidateCache {
+   public:
+    /**
+     * @brief resize cache
+     * @author Matthias Schartner
+     *
+     * Nothing happens if the size did not change.
+     *
+     * @param nsta number of stations
+     * @param nsrc number of sources
+     */
+    void resize( unsigned long nsta, unsigned long nsrc );
+
+
+    /**
+     * @brief calculate azimuth and elevation
+     * @author Matthias Schartner
+     *
+     * same as Station::calcAzEl_simple but reuses previous result if time did not change
+     *
+     * @param station station
+     * @param source observed source
+     * @param p pointing vector (time must be set)
+     */
+    void calcAzEl( const Station &station, const std::shared_ptr<const AbstractSource> &source,
+                   PointingVector &p ) noexcept;
+
+
+    /**
+     * @brief check if source is visible
+     * @author Matthias Schartner
+     *
+     * same as Station::isVisible but reuses previous result if time, station revision and minimum elevation of the
+     * source did not change. Azimuth and elevation of p must be calculated with calcAzEl() beforehand.
+     *
+     * @param station station
+     * @param p pointing vector
+     * @param minElevationSource minimum elevation of source
+     * @return true if source is visible
+     */
+    bool isVisible( const Station &station, const PointingVector &p, double minElevationSource ) noexcept;
+
+
+    /**
+     * @brief unwrap azimuth and calculate slew time from current station position
+     * @author Matthias Schartner
+     *
+     * same as AbstractCableWrap::calcUnwrappedAz followed by Station::slewTime but reuses previous result if station
+     * revision and slew target did not change
+     *
+     * @param station station
+     * @param p pointing vector (azimuth is unwrapped)
+     * @return slew time, none if slew is not possible
+     */
+    boost::optional<unsigned int> unwrapAndSlewTime( const Station &station, PointingVector &p ) noexcept;
+
+
+    /**
+     * @brief getter for number of reused results
+     * @author Matthias Schartner
+     *
+     * @return number of reused results
+     */
+    unsigned long getHits() const noexcept { return hits_; }
+
+
+    /**
+     * @brief getter for number of calculated results
+     * @author Matthias Schartner
+     *
+     * @return number of calculated results
+     */
+    unsigned long getMisses() const noexcept { return misses_; }
+
+
+   private:
+    /**
+     * @brief partial results of one station/source pair
+     * @author Matthias Schartner
+     */
+    struct Entry {
+        unsigned int time = std::numeric_limits<unsigned int>::max();  ///< time of azimuth and elevation
+        double az = 0;                                                  ///< azimuth
+        double el = 0;                                                  ///< elevation
+        double ha = 0;                                                  ///< hour angle
+        double dc = 0;                                                  ///< declination
+
+        unsigned int visibleTime = std::numeric_limits<unsigned int>::max();       ///< time of visibility check
+        unsigned long visibleRevision = std::numeric_limits<unsigned long>::max();  ///< station revision
+        double visibleMinElevation = 0;  ///< minimum elevation of source used for visibility check
+        bool visible = false;            ///< flag if source is visible
+
+        unsigned long revision = std::numeric_limits<unsigned long>::max();  ///< station revision of slew time
+        double targetAz = 0;                                                 ///< azimuth of slew target
+        double targetEl = 0;                                                 ///< elevation of slew target
+        double unwrappedAz = 0;                                              ///< unwrapped azimuth
+        boost::optional<unsigned int> slewTime;                              ///< slew time
+    };
+
+    unsigned long nsta_ = 0;     ///< number of stations
+    unsigned long nsrc_ = 0;     ///< number of sources
+    std::vector<Entry> entries_;  ///< entries (station major)
+
+    unsigned long hits_ = 0;    ///< number of reused results
+    unsigned long misses_ = 0;  ///< number of calculated results
+
+
+    /**
+     * @brief count reused or calculated result
+     * @author Matthias Schartner
+     *
+     * @param hit true if result was reused
+     */
+    void count( bool hit ) noexcept;
+};
+}  // namespace VieVS
+
+#endif  // CANDIDATECACHE_H
@@ -0,0 +1,217 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CandidateTable.h"
+
+#include <algorithm>
+
+
+using namespace std;
+using namespace VieVS;
+
+
+void CandidateTable::reset( unsigned long nsta ) noexcept {
+    networkSize_ = nsta;
+    nMaskWords_ = ( nsta + 63 ) / 64;
+    startTimes_ = false;
+
+    srcid_.clear();
+    type_.clear();
+    first_.clear();
+    nRows_.clear();
+    nsta_.clear();
+    mask_.clear();
+    bound_.clear();
+
+    staid_.clear();
+    endOfLastScan_.clear();
+    time_.clear();
+    az_.clear();
+    el_.clear();
+    ha_.clear();
+    dc_.clear();
+    fieldSystem_.clear();
+    slew_.clear();
+    preob_.clear();
+
+    pendingFirst_ = 0;
+    pendingMask_.assign( nMaskWords_, 0 );
+}
+
+
+void CandidateTable::addRow( unsigned int endOfLastScan, const PointingVector &p ) noexcept {
+    unsigned long staid = p.getStaid();
+    staid_.push_back( staid );
+    endOfLastScan_.push_back( endOfLastScan );
+    time_.push_back( p.getTime() );
+    az_.push_back( p.getAz() );
+    el_.push_back( p.getEl() );
+    ha_.push_back( p.getHa() );
+    dc_.push_back( p.getDc() );
+    fieldSystem_.push_back( 0 );
+    slew_.push_back( 0 );
+    preob_.push_back( 0 );
+    pendingMask_[staid / 64] |= uint64_t{ 1 } << ( staid % 64 );
+}
+
+
+void CandidateTable::addCandidate( unsigned long srcid, Scan::ScanType type ) noexcept {
+    srcid_.push_back( srcid );
+    type_.push_back( type );
+    first_.push_back( pendingFirst_ );
+    nRows_.push_back( staid_.size() - pendingFirst_ );
+    nsta_.push_back( staid_.size() - pendingFirst_ );
+    mask_.insert( mask_.end(), pendingMask_.begin(), pendingMask_.end() );
+    bound_.push_back( numeric_limits<double>::infinity() );
+
+    pendingFirst_ = staid_.size();
+    fill( pendingMask_.begin(), pendingMask_.end(), 0 );
+}
+
+
+void CandidateTable::discardPending() noexcept {
+    staid_.resize( pendingFirst_ );
+    endOfLastScan_.resize( pendingFirst_ );
+    time_.resize( pendingFirst_ );
+    az_.resize( pendingFirst_ );
+    el_.resize( pendingFirst_ );
+    ha_.resize( pendingFirst_ );
+    dc_.resize( pendingFirst_ );
+    fieldSystem_.resize( pendingFirst_ );
+    slew_.resize( pendingFirst_ );
+    preob_.resize( pendingFirst_ );
+    fill( pendingMask_.begin(), pendingMask_.end(), 0 );
+}
+
+
+void CandidateTable::compact( const std::vector<char> &keep ) noexcept {
+    unsigned long nKept = 0;
+    unsigned long nRowsKept = 0;
+    for ( unsigned long c = 0; c < srcid_.size(); ++c ) {
+        if ( !keep[c] ) {
+            continue;
+        }
+
+        // rows of kept candidates are moved to the front (rows of a candidate are contiguous)
+        unsigned long first = first_[c];
+        for ( unsigned long r = first; r < first + nRows_[c]; ++r, ++nRowsKept ) {
+            staid_[nRowsKept] = staid_[r];
+            endOfLastScan_[nRowsKept] = endOfLastScan_[r];
+            time_[nRowsKept] = time_[r];
+            az_[nRowsKept] = az_[r];
+            el_[nRowsKept] = el_[r];
+            ha_[nRowsKept] = ha_[r];
+            dc_[nRowsKept] = dc_[r];
+            fieldSystem_[nRowsKept] = fieldSystem_[r];
+            slew_[nRowsKept] = slew_[r];
+            preob_[nRowsKept] = preob_[r];
+        }
+
+        srcid_[nKept] = srcid_[c];
+        type_[nKept] = type_[c];
+        first_[nKept] = nRowsKept - nRows_[c];
+        nRows_[nKept] = nRows_[c];
+        nsta_[nKept] = nsta_[c];
+        copy( mask_.begin() + c * nMaskWords_, mask_.begin() + ( c + 1 ) * nMaskWords_,
+              mask_.begin() + nKept * nMaskWords_ );
+        bound_[nKept] = bound_[c];
+        ++nKept;
+    }
+
+    srcid_.resize( nKept );
+    type_.resize( nKept );
+    first_.resize( nKept );
+    nRows_.resize( nKept );
+    nsta_.resize( nKept );
+    mask_.resize( nKept * nMaskWords_ );
+    bound_.resize( nKept );
+
+    staid_.resize( nRowsKept );
+    endOfLastScan_.resize( nRowsKept );
+    time_.resize( nRowsKept );
+    az_.resize( nRowsKept );
+    el_.resize( nRowsKept );
+    ha_.resize( nRowsKept );
+    dc_.resize( nRowsKept );
+    fieldSystem_.resize( nRowsKept );
+    slew_.resize( nRowsKept );
+    preob_.resize( nRowsKept );
+    pendingFirst_ = nRowsKept;
+}
+
+
+void CandidateTable::split( const std::vector<char> &keep, CandidateTable &removed ) noexcept {
+    if ( removed.networkSize_ != networkSize_ || removed.empty() ) {
+        removed.reset( networkSize_ );
+        removed.startTimes_ = startTimes_;
+    }
+
+    for ( unsigned long c = 0; c < srcid_.size(); ++c ) {
+        if ( keep[c] ) {
+            continue;
+        }
+
+        unsigned long first = first_[c];
+        unsigned long last = first + nRows_[c];
+        removed.staid_.insert( removed.staid_.end(), staid_.begin() + first, staid_.begin() + last );
+        removed.endOfLastScan_.insert( removed.endOfLastScan_.end(), endOfLastScan_.begin() + first,
+                                       endOfLastScan_.begin() + last );
+        removed.time_.insert( removed.time_.end(), time_.begin() + first, time_.begin() + last );
+        removed.az_.insert( removed.az_.end(), az_.begin() + first, az_.begin() + last );
+        removed.el_.insert( removed.el_.end(), el_.begin() + first, el_.begin() + last );
+        removed.ha_.insert( removed.ha_.end(), ha_.begin() + first, ha_.begin() + last );
+        removed.dc_.insert( removed.dc_.end(), dc_.begin() + first, dc_.begin() + last );
+        removed.fieldSystem_.insert( removed.fieldSystem_.end(), fieldSystem_.begin() + first,
+                                     fieldSystem_.begin() + last );
+        removed.slew_.insert( removed.slew_.end(), slew_.begin() + first, slew_.begin() + last );
+        removed.preob_.insert( removed.preob_.end(), preob_.begin() + first, preob_.begin() + last );
+
+        removed.srcid_.push_back( srcid_[c] );
+        removed.type_.push_back( type_[c] );
+        removed.first_.push_back( removed.pendingFirst_ );
+        removed.nRows_.push_back( nRows_[c] );
+        removed.nsta_.push_back( nsta_[c] );
+        removed.mask_.insert( removed.mask_.end(), mask_.begin() + c * nMaskWords_,
+                              mask_.begin() + ( c + 1 ) * nMaskWords_ );
+        removed.bound_.push_back( bound_[c] );
+        removed.pendingFirst_ = removed.staid_.size();
+    }
+
+    compact( keep );
+}
+
+
+void CandidateTable::stationIds( unsigned long c, std::vector<unsigned long> &staids ) const noexcept {
+    staids.clear();
+    for ( unsigned long r = firstRow( c ); r < endRow( c ); ++r ) {
+        if ( isActive( c, r ) ) {
+            staids.push_back( staid_[r] );
+        }
+    }
+}
+
+
+PointingVector CandidateTable::pointingVector( unsigned long c, unsigned long r ) const noexcept {
+    PointingVector p( staid_[r], srcid_[c] );
+    p.setTime( time_[r] );
+    p.setAz( az_[r] );
+    p.setEl( el_[r] );
+    p.setHa( ha_[r] );
+    p.setDc( dc_[r] );
+    return p;
+}
@@ -0,0 +1,414 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file CandidateTable.h
+ * @brief class CandidateTable
+ *
+ * @author Matthias Schartner
+ * @date 16.10.2026
+ */
+
+#ifndef CANDIDATETABLE_H
+#define CANDIDATETABLE_H
+
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "PointingVector.h"
+#include "Scan.h"
+
+
+namespace VieVS {
+
+/**
+ * @class CandidateTable
+ * @brief columnar store of single source scan candidates
+ *
+ * Each candidate (one per source) consists of one row per visible station. All values are stored in contiguous
+ * arrays, one array per field: per candidate the source id, scan type, station bit mask, number of stations and the
+ * score upper bound, per row the station id, end of last scan, pointing direction and field system, slew and preob
+ * times.
+ *
+ * Stations are removed from a candidate by clearing their bit in the station mask, invalid candidates are removed
+ * with compact() in one order preserving pass. Full Scan objects are only created for the remaining candidates.
+ *
+ * Rows of different candidates are independent, thus candidates can be evaluated from multiple threads.
+ *
+ * @author Matthias Schartner
+ * @date 16.10.2026
+ */
+class CandidateTable {
+   public:
+    /**
+     * @brief remove all candidates and set number of stations
+     * @author Matthias Schartner
+     *
+     * @param nsta number of stations in network
+     */
+    void reset( unsigned long nsta ) noexcept;
+
+
+    /**
+     * @brief getter for number of stations in network
+     * @author Matthias Schartner
+     *
+     * @return number of stations in network
+     */
+    unsigned long getNetworkSize() const noexcept { return networkSize_; }
+
+
+    /**
+     * @brief getter for number of candidates
+     * @author Matthias Schartner
+     *
+     * @return number of candidates
+     */
+    unsigned long size() const noexcept { return srcid_.size(); }
+
+
+    /**
+     * @brief check if there are no candidates
+     * @author Matthias Schartner
+     *
+     * @return true if there are no candidates
+     */
+    bool empty() const noexcept { return srcid_.empty(); }
+
+
+    /**
+     * @brief add station to the candidate which is currently created
+     * @author Matthias Schartner
+     *
+     * @param endOfLastScan end of last scan of this station
+     * @param p pointing vector with station id, time, azimuth, elevation, hour angle and declination
+     */
+    void addRow( unsigned int endOfLastScan, const PointingVector &p ) noexcept;
+
+
+    /**
+     * @brief check if station was added to the candidate which is currently created
+     * @author Matthias Schartner
+     *
+     * @param staid station id
+     * @return true if station was added
+     */
+    bool hasPendingStation( unsigned long staid ) const noexcept {
+        return ( pendingMask_[staid / 64] >> ( staid % 64 ) & 1u ) != 0;
+    }
+
+
+    /**
+     * @brief finish candidate which is currently created
+     * @author Matthias Schartner
+     *
+     * @param srcid source id
+     * @param type scan type
+     */
+    void addCandidate( unsigned long srcid, Scan::ScanType type ) noexcept;
+
+
+    /**
+     * @brief discard all rows of the candidate which is currently created
+     * @author Matthias Schartner
+     */
+    void discardPending() noexcept;
+
+
+    /**
+     * @brief remove all candidates which are not flagged in one order preserving pass
+     * @author Matthias Schartner
+     *
+     * @param keep flag per candidate (true if candidate is kept)
+     */
+    void compact( const std::vector<char> &keep ) noexcept;
+
+
+    /**
+     * @brief move all candidates which are not flagged to other table, order of both tables is preserved
+     * @author Matthias Schartner
+     *
+     * @param keep flag per candidate (true if candidate is kept)
+     * @param removed table which gets all removed candidates (appended)
+     */
+    void split( const std::vector<char> &keep, CandidateTable &removed ) noexcept;
+
+
+    /**
+     * @brief getter for source id
+     * @author Matthias Schartner
+     *
+     * @param c candidate index
+     * @return source id
+     */
+    unsigned long getSrcid( unsigned long c ) const noexcept { return srcid_[c]; }
+
+
+    /**
+     * @brief getter for scan type
+     * @author Matthias Schartner
+     *
+     * @param c candidate index
+     * @return scan type
+     */
+    Scan::ScanType getType( unsigned long c ) const noexcept { return type_[c]; }
+
+
+    /**
+     * @brief getter for number of stations
+     * @author Matthias Schartner
+     *
+     * @param c candidate index
+     * @return number of stations which are still part of the candidate
+     */
+    unsigned long getNSta( unsigned long c ) const noexcept { return nsta_[c]; }
+
+
+    /**
+     * @brief getter for first row of candidate
+     * @author Matthias Schartner
+     *
+     * @param c candidate index
+     * @return index of first row
+     */
+    unsigned long firstRow( unsigned long c ) const noexcept { return first_[c]; }
+
+
+    /**
+     * @brief getter for end of rows of candidate
+     * @author Matthias Schartner
+     *
+     * Rows of removed stations are kept, use isActive() to check if a row is still part of the candidate.
+     *
+     * @param c candidate index
+     * @return index after last row
+     */
+    unsigned long endRow( unsigned long c ) const noexcept { return first_[c] + nRows_[c]; }
+
+
+    /**
+     * @brief check if station of row is still part of candidate
+     * @author Matthias Schartner
+     *
+     * @param c candidate index
+     * @param r row index
+     * @return true if station is part of candidate
+     */
+    bool isActive( unsigned long c, unsigned long r ) const noexcept {
+        unsigned long staid = staid_[r];
+        return ( mask_[c * nMaskWords_ + staid / 64] >> ( staid % 64 ) & 1u ) != 0;
+    }
+
+
+    /**
+     * @brief remove station of row from candidate
+     * @author Matthias Schartner
+     *
+     * @param c candidate index
+     * @param r row index
+     */
+    void removeStation( unsigned long c, unsigned long r ) noexcept {
+        unsigned long staid = staid_[r];
+        mask_[c * nMaskWords_ + staid / 64] &= ~( uint64_t{ 1 } << ( staid % 64 ) );
+        --nsta_[c];
+    }
+
+
+    /**
+     * @brief station ids of all stations which are still part of candidate
+     * @author Matthias Schartner
+     *
+     * @param c candidate index
+     * @param staids station ids (output, increasing row order)
+     */
+    void stationIds( unsigned long c, std::vector<unsigned long> &staids ) const noexcept;
+
+
+    /**
+     * @brief set flag if start times are calculated
+     * @author Matthias Schartner
+     *
+     * @param flag true if field system, slew and preob times are calculated
+     */
+    void setStartTimes( bool flag ) noexcept { startTimes_ = flag; }
+
+
+    /**
+     * @brief check if start times are calculated
+     * @author Matthias Schartner
+     *
+     * @return true if field system, slew and preob times are calculated
+     */
+    bool hasStartTimes() const noexcept { return startTimes_; }
+
+
+    /**
+     * @brief pointing vector of row
+     * @author Matthias Schartner
+     *
+     * @param c candidate index
+     * @param r row index
+     * @return pointing vector with time, azimuth, elevation, hour angle and declination of row
+     */
+    PointingVector pointingVector( unsigned long c, unsigned long r ) const noexcept;
+
+
+    /**
+     * @brief store (unwrapped) azimuth of row
+     * @author Matthias Schartner
+     *
+     * @param r row index
+     * @param az azimuth
+     */
+    void setAz( unsigned long r, double az ) noexcept { az_[r] = az; }
+
+
+    /**
+     * @brief store field system, slew and preob time of row
+     * @author Matthias Schartner
+     *
+     * @param r row index
+     * @param fieldSystem field system time
+     * @param slew slew time
+     * @param preob preob time
+     */
+    void setTimes( unsigned long r, unsigned int fieldSystem, unsigned int slew, unsigned int preob ) noexcept {
+        fieldSystem_[r] = fieldSystem;
+        slew_[r] = slew;
+        preob_[r] = preob;
+    }
+
+
+    /**
+     * @brief getter for station id of row
+     * @author Matthias Schartner
+     *
+     * @param r row index
+     * @return station id
+     */
+    unsigned long getStaid( unsigned long r ) const noexcept { return staid_[r]; }
+
+
+    /**
+     * @brief getter for end of last scan of row
+     * @author Matthias Schartner
+     *
+     * @param r row index
+     * @return end of last scan
+     */
+    unsigned int getEndOfLastScan( unsigned long r ) const noexcept { return endOfLastScan_[r]; }
+
+
+    /**
+     * @brief getter for field system time of row
+     * @author Matthias Schartner
+     *
+     * @param r row index
+     * @return field system time
+     */
+    unsigned int getFieldSystem( unsigned long r ) const noexcept { return fieldSystem_[r]; }
+
+
+    /**
+     * @brief getter for slew time of row
+     * @author Matthias Schartner
+     *
+     * @param r row index
+     * @return slew time
+     */
+    unsigned int getSlew( unsigned long r ) const noexcept { return slew_[r]; }
+
+
+    /**
+     * @brief getter for preob time of row
+     * @author Matthias Schartner
+     *
+     * @param r row index
+     * @return preob time
+     */
+    unsigned int getPreob( unsigned long r ) const noexcept { return preob_[r]; }
+
+
+    /**
+     * @brief end of slew time of row
+     * @author Matthias Schartner
+     *
+     * same as ScanTimes::getSlewTime( idx, Timestamp::end ) after ScanTimes::addTimes()
+     *
+     * @param r row index
+     * @return end of slew time
+     */
+    unsigned int getEndOfSlew( unsigned long r ) const noexcept {
+        return endOfLastScan_[r] + fieldSystem_[r] + slew_[r];
+    }
+
+
+    /**
+     * @brief store score upper bound
+     * @author Matthias Schartner
+     *
+     * @param c candidate index
+     * @param bound score upper bound
+     */
+    void setScoreBound( unsigned long c, double bound ) noexcept { bound_[c] = bound; }
+
+
+    /**
+     * @brief getter for score upper bound
+     * @author Matthias Schartner
+     *
+     * @param c candidate index
+     * @return score upper bound (infinity if not calculated)
+     */
+    double getScoreBound( unsigned long c ) const noexcept { return bound_[c]; }
+
+
+   private:
+    unsigned long networkSize_ = 0;  ///< number of stations in network
+    unsigned long nMaskWords_ = 0;   ///< number of 64 bit words per station mask
+    bool startTimes_ = false;        ///< flag if start times are calculated
+
+    // per candidate
+    std::vector<unsigned long> srcid_;  ///< source id
+    std::vector<Scan::ScanType> type_;  ///< scan type
+    std::vector<unsigned long> first_;  ///< index of first row
+    std::vector<unsigned long> nRows_;  ///< number of rows
+    std::vector<unsigned long> nsta_;   ///< number of stations which are still part of the candidate
+    std::vector<uint64_t> mask_;        ///< flattened station masks (nMaskWords_ words per candidate)
+    std::vector<double> bound_;         ///< score upper bound
+
+    // per row
+    std::vector<unsigned long> staid_;         ///< station id
+    std::vector<unsigned int> endOfLastScan_;  ///< end of last scan
+    std::vector<unsigned int> time_;           ///< time of pointing direction
+    std::vector<double> az_;                   ///< azimuth (unwrapped after start time calculation)
+    std::vector<double> el_;                   ///< elevation
+    std::vector<double> ha_;                   ///< hour angle
+    std::vector<double> dc_;                   ///< declination
+    std::vector<unsigned int> fieldSystem_;    ///< field system time
+    std::vector<unsigned int> slew_;           ///< slew time
+    std::vector<unsigned int> preob_;          ///< preob time
+
+    unsigned long pendingFirst_ = 0;     ///< first row of candidate which is currently created
+    std::vector<uint64_t> pendingMask_;  ///< station mask of candidate which is currently created
+};
+}  // namespace VieVS
+
+#endif  // CANDIDATETABLE_H
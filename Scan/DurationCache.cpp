@@ -0,0 +1,112 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DurationCache.h"
+
+
+using namespace std;
+using namespace VieVS;
+
+bool DurationCache::enabled = false;
+unsigned long DurationCache::maxEntries = 65536;
+unsigned int DurationCache::timeQuantization = 0;
+double DurationCache::elevationQuantization = 0;
+
+
+DurationCache::Key DurationCache::createKey( const Network &network,
+                                             const std::shared_ptr<const AbstractSource> &source,
+                                             const std::shared_ptr<const Mode> &mode, const Observation &obs,
+                                             double el1, double el2 ) noexcept {
+    unsigned long staid1 = obs.getStaid1();
+    unsigned long staid2 = obs.getStaid2();
+    if ( staid1 > staid2 ) {
+        swap( staid1, staid2 );
+        swap( el1, el2 );
+    }
+
+    Key key;
+    key.srcid = source->getId();
+    key.blid = obs.getBlid();
+    key.modeId = mode->getId();
+    key.events[0] = network.getStation( staid1 ).getNextEvent();
+    key.events[1] = network.getStation( staid2 ).getNextEvent();
+    key.events[2] = network.getBaseline( key.blid ).getNextEvent();
+    key.events[3] = source->getNextEvent();
+    key.time = quantize( obs.getStartTime(), timeQuantization );
+    key.el1 = quantize( el1, elevationQuantization );
+    key.el2 = quantize( el2, elevationQuantization );
+    return key;
+}
+
+
+void DurationCache::resize( unsigned long nbls, unsigned long nsrc ) {
+    if ( nbls == nbls_ && nsrc == nsrc_ ) {
+        return;
+    }
+    nbls_ = nbls;
+    nsrc_ = nsrc;
+
+    unsigned long n = 1;
+    while ( n < nbls * nsrc && n < maxEntries ) {
+        n *= 2;
+    }
+    entries_.assign( n, Entry() );
+    pending_.clear();
+}
+
+
+bool DurationCache::find( const Key &key, Duration &duration ) noexcept {
+    const Entry &entry = entries_[slot( key )];
+    const Key &other = entry.key;
+    bool hit = entry.valid && other.srcid == key.srcid && other.blid == key.blid && other.modeId == key.modeId &&
+               other.events[0] == key.events[0] && other.events[1] == key.events[1] &&
+               other.events[2] == key.events[2] && other.events[3] == key.events[3] && other.time == key.time &&
+               other.el1 == key.el1 && other.el2 == key.el2;
+    if ( hit ) {
+        duration = entry.duration;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++hits_;
+    } else {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++misses_;
+    }
+    return hit;
+}
+
+
+void DurationCache::store( const Key &key, const Duration &duration ) noexcept {
+#ifdef _OPENMP
+#pragma omp critical( DurationCache_store )
+#endif
+    pending_.emplace_back( key, duration );
+}
+
+
+void DurationCache::flush() noexcept {
+    for ( const auto &any : pending_ ) {
+        Entry &entry = entries_[slot( any.first )];
+        entry.valid = true;
+        entry.key = any.first;
+        entry.duration = any.second;
+    }
+    pending_.clear();
+}
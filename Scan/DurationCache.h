@@ -0,0 +1,232 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file DurationCache.h
+ * @brief class DurationCache
+ *
+ * @author Matthias Schartner
+ * @date 15.10.2026
+ */
+
+#ifndef DURATIONCACHE_H
+#define DURATIONCACHE_H
+
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "../ObservingMode/Mode.h"
+#include "../Source/AbstractSource.h"
+#include "../Station/Network.h"
+#include "Observation.h"
+
+
+namespace VieVS {
+
+/**
+ * @class DurationCache
+ * @brief required observing durations per source and baseline which are reused between scan selections
+ *
+ * The required observing duration of an observation only depends on the observed flux density (source, baseline and
+ * time), the SEFD of both stations (elevation), the observing mode and the station, baseline and source parameters
+ * (minimum SNR, correlator synchronization time, minimum and maximum scan time).
+ *
+ * Results are stored in a bounded direct mapped table (at most maxEntries entries, slot from hash of source and
+ * baseline id). A result is reused if start time and elevations fall into the same quantization interval and if the
+ * observing mode and the event indices of both stations, the baseline and the source did not change. Therefore,
+ * parameter events (e.g. a new minimum SNR) invalidate all affected entries. A quantization of zero requires an exact
+ * match, which rarely happens between consecutive scan selections, therefore the cache is disabled by default.
+ *
+ * find() can be called from multiple threads. New results are only collected by store() and are written to the table
+ * in flush(), which must not be called concurrently with find().
+ *
+ * @author Matthias Schartner
+ * @date 15.10.2026
+ */
+class DurationCache {
+   public:
+    static bool enabled;                   ///< flag if cache is used
+    static unsigned long maxEntries;       ///< maximum number of cached results (power of two)
+    static unsigned int timeQuantization;  ///< quantization of observation start time in seconds (0 = exact)
+    static double elevationQuantization;   ///< quantization of station elevations in radians (0 = exact)
+
+
+    /**
+     * @brief required observing duration of one observation
+     * @author Matthias Schartner
+     */
+    struct Duration {
+        /**
+         * @brief outcome of observing duration calculation
+         * @author Matthias Schartner
+         */
+        enum class Status : unsigned char {
+            valid,            ///< observing duration is valid
+            tooLong,          ///< observing duration exceeds maximum scan time of baseline
+            noRecordingRate,  ///< no recording rate for at least one band
+        };
+
+        Status status = Status::valid;  ///< outcome of observing duration calculation
+        unsigned int duration = 0;      ///< required observing duration in seconds
+    };
+
+
+    /**
+     * @brief lookup key of one observation
+     * @author Matthias Schartner
+     */
+    struct Key {
+        unsigned long srcid = 0;      ///< source id
+        unsigned long blid = 0;       ///< baseline id
+        unsigned long modeId = 0;     ///< observing mode id
+        unsigned int events[4] = {};  ///< next event index of station 1, station 2, baseline and source
+        double time = 0;              ///< quantized start time
+        double el1 = 0;               ///< quantized elevation of station with lower id
+        double el2 = 0;               ///< quantized elevation of station with higher id
+    };
+
+
+    /**
+     * @brief create lookup key of an observation
+     * @author Matthias Schartner
+     *
+     * @param network station network
+     * @param source observed source
+     * @param mode observing mode
+     * @param obs observation
+     * @param el1 elevation of station 1 of this observation
+     * @param el2 elevation of station 2 of this observation
+     * @return lookup key
+     */
+    static Key createKey( const Network &network, const std::shared_ptr<const AbstractSource> &source,
+                          const std::shared_ptr<const Mode> &mode, const Observation &obs, double el1,
+                          double el2 ) noexcept;
+
+
+    /**
+     * @brief resize cache
+     * @author Matthias Schartner
+     *
+     * The table holds one entry per source/baseline pair but at most maxEntries entries (rounded up to a power of
+     * two). Nothing happens if the size did not change.
+     *
+     * @param nbls number of baselines
+     * @param nsrc number of sources
+     */
+    void resize( unsigned long nbls, unsigned long nsrc );
+
+
+    /**
+     * @brief find required observing duration
+     * @author Matthias Schartner
+     *
+     * @param key lookup key
+     * @param duration required observing duration (only set if found)
+     * @return true if duration was found, otherwise false
+     */
+    bool find( const Key &key, Duration &duration ) noexcept;
+
+
+    /**
+     * @brief store required observing duration
+     * @author Matthias Schartner
+     *
+     * The result is only collected and becomes visible after flush(). Thread safe.
+     *
+     * @param key lookup key
+     * @param duration required observing duration
+     */
+    void store( const Key &key, const Duration &duration ) noexcept;
+
+
+    /**
+     * @brief write all results collected by store() to the table
+     * @author Matthias Schartner
+     */
+    void flush() noexcept;
+
+
+    /**
+     * @brief getter for number of reused results
+     * @author Matthias Schartner
+     *
+     * @return number of reused results
+     */
+    unsigned long getHits() const noexcept { return hits_; }
+
+
+    /**
+     * @brief getter for number of calculated results
+     * @author Matthias Schartner
+     *
+     * @return number of calculated results
+     */
+    unsigned long getMisses() const noexcept { return misses_; }
+
+
+   private:
+    /**
+     * @brief stored result of one observation
+     * @author Matthias Schartner
+     */
+    struct Entry {
+        bool valid = false;  ///< flag if entry is set
+        Key key;             ///< lookup key
+        Duration duration;   ///< required observing duration
+    };
+
+    unsigned long nbls_ = 0;                         ///< number of baselines
+    unsigned long nsrc_ = 0;                         ///< number of sources
+    std::vector<Entry> entries_;                     ///< entries (slot from hash of source and baseline id)
+    std::vector<std::pair<Key, Duration>> pending_;  ///< results collected by store()
+
+    unsigned long hits_ = 0;    ///< number of reused results
+    unsigned long misses_ = 0;  ///< number of calculated results
+
+
+    /**
+     * @brief quantize value
+     * @author Matthias Schartner
+     *
+     * @param value value
+     * @param quantization quantization interval (0 = exact)
+     * @return quantized value
+     */
+    static double quantize( double value, double quantization ) noexcept {
+        return quantization > 0 ? std::floor( value / quantization ) : value;
+    }
+
+
+    /**
+     * @brief table slot of a key
+     * @author Matthias Schartner
+     *
+     * @param key lookup key
+     * @return slot index
+     */
+    unsigned long slot( const Key &key ) const noexcept {
+        return ( key.srcid * 73856093ul ^ key.blid * 19349663ul ) & ( entries_.size() - 1 );
+    }
+};
+}  // namespace VieVS
+
+#endif  // DURATIONCACHE_H
@@ -22,12 +22,12 @@
 using namespace VieVS;
 using namespace std;
 
-unsigned long VieVS::Observation::nextId = 0;
+VieVS::IdCounter VieVS::Observation::nextId{ 0 };
 
 
 Observation::Observation( unsigned long blid, unsigned long staid1, unsigned long staid2, unsigned long srcid,
                           unsigned int startTime, unsigned int observingTime )
-    : VieVS_Object( nextId++ ),
+    : VieVS_Object( nextId.next() ),
       blid_{ blid },
       staid1_{ staid1 },
       staid2_{ staid2 },
@@ -37,7 +37,7 @@ Observation::Observation( unsigned long blid, unsigned long staid1, unsigned lon
 
 
 Observation::Observation( const Observation &other )
-    : VieVS_Object{ nextId++ },
+    : VieVS_Object{ nextId.next() },
       blid_{ other.blid_ },
       staid1_{ other.staid1_ },
       staid2_{ other.staid2_ },
@@ -28,6 +28,7 @@
 #define OBSERVATION_H
 
 
+#include "../Misc/ObjectCounter.h"
 #include "../Misc/VieVS_Object.h"
 
 
@@ -154,7 +155,7 @@ class Observation : public VieVS_Object {
      *
      * @return total number of created observations
      */
-    static unsigned long numberOfCreatedObjects() { return nextId; }
+    static unsigned long numberOfCreatedObjects() { return nextId.get(); }
 
     /**
      * @brief add noise to observed minus computed
@@ -165,7 +166,7 @@ class Observation : public VieVS_Object {
     void addNoise( double noise ) { o_c += noise; }
 
    private:
-    static unsigned long nextId;  ///< next id for this object type
+    static IdCounter nextId;  ///< next id for this object type
 
     unsigned long blid_;    ///< baseline id
     unsigned long staid1_;  ///< first station id
@@ -28,17 +28,19 @@
 
 using namespace std;
 using namespace VieVS;
-unsigned long PointingVector::nextId = 0;
+#ifndef VIESCHEDPP_NO_POINTINGVECTOR_IDS
+IdCounter PointingVector::nextId{ 0 };
+#endif
 
 // PointingVector::PointingVector():VieVS_Object(nextId++), staid_{-1}, srcid_{-1}{
 //}
 
 PointingVector::PointingVector( unsigned long staid, unsigned long srcid )
-    : VieVS_Object( nextId++ ), staid_{ staid }, srcid_{ srcid } {}
+    : VieVS_Object( newId() ), staid_{ staid }, srcid_{ srcid } {}
 
 
 PointingVector::PointingVector( const PointingVector &other )
-    : VieVS_Object( nextId++ ),
+    : VieVS_Object( newId() ),
       staid_{ other.staid_ },
       srcid_{ other.srcid_ },
       az_{ other.az_ },
@@ -33,6 +33,7 @@
 #include <limits>
 
 #include "../Misc/Constants.h"
+#include "../Misc/ObjectCounter.h"
 #include "../Misc/VieVS_Object.h"
 
 
@@ -234,11 +235,34 @@ class PointingVector : public VieVS_Object {
      *
      * @return total nubmer of created pointing vectors
      */
-    static unsigned long numberOfCreatedObjects() { return nextId - 1; }
+#ifdef VIESCHEDPP_NO_POINTINGVECTOR_IDS
+    static unsigned long numberOfCreatedObjects() { return ThreadLocalCounter<PointingVector>::get() - 1; }
+#else
+    static unsigned long numberOfCreatedObjects() { return nextId.get() - 1; }
+#endif
 
 
    private:
-    static unsigned long nextId;  ///< next id for this object type
+#ifndef VIESCHEDPP_NO_POINTINGVECTOR_IDS
+    static IdCounter nextId;  ///< next id for this object type
+#endif
+
+    /**
+     * @brief id for new pointing vector
+     * @author Matthias Schartner
+     *
+     * If ids are compiled out (VIESCHEDPP_NO_POINTINGVECTOR_IDS) all pointing vectors have id 0 and are only counted.
+     *
+     * @return new id
+     */
+    static unsigned long newId() noexcept {
+#ifdef VIESCHEDPP_NO_POINTINGVECTOR_IDS
+        ThreadLocalCounter<PointingVector>::increment();
+        return 0;
+#else
+        return nextId.next();
+#endif
+    }
 
     unsigned long staid_;  ///< station id
     unsigned long srcid_;  ///< source id
@@ -37,11 +37,12 @@ thread_local unsigned int Scan::scanSequence_modulo = 0;  ///< modulo of scan se
 std::map<unsigned int, std::vector<unsigned long>>
     Scan::scanSequence_target;  ///< map with modulo number as key and list of target source ids as value
 
-unsigned long Scan::nextId = 0;
+IdCounter Scan::nextId{ 0 };
 
 
-Scan::Scan( vector<PointingVector> &pointingVectors, vector<unsigned int> &endOfLastScan, ScanType type )
-    : VieVS_Object( nextId++ ),
+Scan::Scan( vector<PointingVector> &pointingVectors, vector<unsigned int> &endOfLastScan, ScanType type,
+            ScanPool *pool )
+    : VieVS_Object( nextId.next() ),
       times_{ ScanTimes( static_cast<unsigned int>( pointingVectors.size() ) ) },
       pointingVectorsStart_{ move( pointingVectors ) },
       type_{ type },
@@ -50,12 +51,17 @@ Scan::Scan( vector<PointingVector> &pointingVectors, vector<unsigned int> &endOf
     nsta_ = Scan::pointingVectorsStart_.size();
     srcid_ = Scan::pointingVectorsStart_.at( 0 ).getSrcid();
     times_.setEndOfLastScan( endOfLastScan );
+    if ( pool != nullptr ) {
+        observations_ = pool->takeObservations();
+        pointingVectorsEnd_ = pool->takePointingVectors();
+    }
     observations_.reserve( ( nsta_ * ( nsta_ - 1 ) ) / 2 );
+    updateStationLookup();
 }
 
 
 Scan::Scan( vector<PointingVector> pv, ScanTimes times, vector<Observation> obs, ScanType type )
-    : VieVS_Object( nextId++ ),
+    : VieVS_Object( nextId.next() ),
       srcid_{ pv[0].getSrcid() },
       nsta_{ static_cast<unsigned long>(pv.size()) },
       pointingVectorsStart_{ move( pv ) },
@@ -65,11 +71,12 @@ Scan::Scan( vector<PointingVector> pv, ScanTimes times, vector<Observation> obs,
       constellation_{ ScanConstellation::subnetting },
       type_{ type } {
     times_.giveNewId();
+    updateStationLookup();
 }
 
 Scan::Scan( const boost::property_tree::ptree &ptree, Network &network, const SourceList &sourceList,
             Scan::ScanType type )
-    : VieVS_Object( nextId++ ),
+    : VieVS_Object( nextId.next() ),
       times_{ ScanTimes( static_cast<unsigned int>( 0 ) ) },
       score_{ 0 },
       srcid_{ 0 },
@@ -127,6 +134,7 @@ Scan::Scan( const boost::property_tree::ptree &ptree, Network &network, const So
     }
 
 
+    updateStationLookup();
     times_ = ScanTimes( static_cast<unsigned int>( nsta_ ) );
     setScanTimes( eols, system_delays, vector<unsigned int>( nsta_, 0 ), preobs, observation_start, observation_end );
 
@@ -244,6 +252,7 @@ bool Scan::removeStation( int idx, const shared_ptr<const AbstractSource> &sourc
     if ( !pointingVectorsEnd_.empty() ) {
         pointingVectorsEnd_.erase( next( pointingVectorsEnd_.begin(), idx ) );
     }
+    updateStationLookup();
 
     // remove all observations with this station
     unsigned long nbl_before = observations_.size();
@@ -420,14 +429,14 @@ unordered_map<string, double> Scan::calcSNR( const Network &network,
 
     // loop over each band
     bool flag_observationRemoved = false;
-    for ( auto &band : mode->getAllBands() ) {
+    for ( unsigned long bandId : mode->getAllBandIds() ) {
         double SEFD_src;
-        if ( source->hasFluxInformation( band ) ) {
+        if ( source->hasFluxInformation( bandId ) ) {
             // calculate observed flux density for each band
-            SEFD_src = source->observedFlux( band, startTime, gmst, network.getDxyz( staid1, staid2 ) );
-        } else if ( ObservingMode::sourceBackup[band] == ObservingMode::Backup::internalModel ) {
+            SEFD_src = source->observedFlux( bandId, startTime, gmst, network.getDxyz( staid1, staid2 ) );
+        } else if ( ObservingMode::sourceBackupIsInternalModel( bandId ) ) {
             // calculate observed flux density based on model
-            double wavelength = ObservingMode::wavelengths[band];
+            double wavelength = ObservingMode::wavelength( bandId );
             SEFD_src = source->observedFlux_model( wavelength, startTime, gmst, network.getDxyz( staid1, staid2 ) );
         } else {
             SEFD_src = 1e-3;
@@ -440,21 +449,21 @@ unordered_map<string, double> Scan::calcSNR( const Network &network,
 
         // calculate system equivalent flux density for each station
         double el1 = pointingVectorsStart_[*findIdxOfStationId( staid1 )].getEl();
-        double SEFD_sta1 = sta1.getEquip().getSEFD( band, el1 );
+        double SEFD_sta1 = sta1.getEquip().getSEFD( bandId, el1 );
         double el2 = pointingVectorsStart_[*findIdxOfStationId( staid2 )].getEl();
-        double SEFD_sta2 = sta2.getEquip().getSEFD( band, el2 );
+        double SEFD_sta2 = sta2.getEquip().getSEFD( bandId, el2 );
 
         double efficiency = mode->efficiency( sta1.getId(), sta2.getId() );
-        double rec = mode->recordingRate( staid1, staid2, band );
+        double rec = mode->recordingRate( staid1, staid2, bandId );
         double SNR = efficiency * SEFD_src / sqrt( SEFD_sta1 * SEFD_sta2 ) * sqrt( rec * duration );
-        band2snr[band] = SNR;
+        band2snr[BandRegistry::name( bandId )] = SNR;
     }
     return band2snr;
 }
 
 
 bool Scan::calcObservationDuration( const Network &network, const std::shared_ptr<const AbstractSource> &source,
-                                    const std::shared_ptr<const Mode> &mode ) noexcept {
+                                    const std::shared_ptr<const Mode> &mode, DurationCache *cache ) noexcept {
 #ifdef VIESCHEDPP_LOG
     if ( Flags::logTrace )
         BOOST_LOG_TRIVIAL( trace ) << "scan " << this->printId() << " calc required observing time per observation";
@@ -484,10 +493,93 @@ bool Scan::calcObservationDuration( const Network &network, const std::shared_pt
         return true;
     }
 
-    // loop over all observed baselines
-    int idxObs = 0;
-    while ( idxObs < observations_.size() ) {
-        auto &thisObservation = observations_[idxObs];
+    const vector<unsigned long> &bandIds = mode->getAllBandIds();
+    unsigned long nBands = bandIds.size();
+    unsigned long nObs = observations_.size();
+    static thread_local vector<DurationCache::Duration> blid2duration;  // required observing duration per baseline
+    static thread_local vector<DurationCache::Key> keys;
+    static thread_local vector<unsigned long> missing;  // index of observations which are not cached
+    blid2duration.resize( network.getNBls() );
+    keys.resize( nObs );
+    missing.clear();
+
+    // look up cached observing durations
+    for ( unsigned long i = 0; i < nObs; ++i ) {
+        const Observation &obs = observations_[i];
+        if ( cache != nullptr ) {
+            double el1 = pointingVectorsStart_[*findIdxOfStationId( obs.getStaid1() )].getEl();
+            double el2 = pointingVectorsStart_[*findIdxOfStationId( obs.getStaid2() )].getEl();
+            keys[i] = DurationCache::createKey( network, source, mode, obs, el1, el2 );
+            if ( cache->find( keys[i], blid2duration[obs.getBlid()] ) ) {
+                continue;
+            }
+        }
+        missing.push_back( i );
+    }
+    unsigned long nMissing = missing.size();
+
+    // calculate observed flux density of all remaining observations, one batched call per band
+    static thread_local vector<double> obsU;
+    static thread_local vector<double> obsV;
+    static thread_local vector<double> obsGmst;
+    static thread_local vector<double> obsFlux;  // observed flux density per band and observation
+    obsU.resize( nMissing );
+    obsV.resize( nMissing );
+    obsGmst.resize( nMissing );
+    obsFlux.resize( nMissing * nBands );
+
+    // observations with the same start time share greenwich mean sidereal time and source trigonometry
+    unsigned int lastStartTime = numeric_limits<unsigned int>::max();
+    double gmst = 0;
+    AbstractSource::UVProjection projection;
+    for ( unsigned long k = 0; k < nMissing; ++k ) {
+        const Observation &obs = observations_[missing[k]];
+        unsigned int startTime = obs.getStartTime();
+        if ( startTime != lastStartTime ) {
+            // calculate greenwhich meridian sedirial time
+            double date1 = 2400000.5;
+            double date2 = TimeSystem::mjdStart + static_cast<double>( startTime ) / 86400.0;
+            gmst = iauGmst82( date1, date2 );
+            projection = source->calcUVProjection( startTime, gmst );
+            lastStartTime = startTime;
+        }
+        obsGmst[k] = gmst;
+        auto uv = AbstractSource::calcUV( projection, network.getDxyz( obs.getStaid1(), obs.getStaid2() ) );
+        obsU[k] = uv.first;
+        obsV[k] = uv.second;
+    }
+
+    for ( unsigned long iband = 0; iband < nBands && nMissing > 0; ++iband ) {
+        unsigned long bandId = bandIds[iband];
+        double *flux = obsFlux.data() + iband * nMissing;
+        bool hasFluxInformation = source->hasFluxInformation( bandId );
+        if ( hasFluxInformation ) {
+            // calculate observed flux density for each band
+            source->observedFluxes( bandId, nMissing, obsU.data(), obsV.data(), flux );
+        }
+
+        for ( unsigned long k = 0; k < nMissing; ++k ) {
+            const Observation &obs = observations_[missing[k]];
+            if ( !hasFluxInformation ) {
+                if ( ObservingMode::sourceBackupIsInternalModel( bandId ) ) {
+                    // calculate observed flux density based on model
+                    double wavelength = ObservingMode::wavelength( bandId );
+                    flux[k] = source->observedFlux_model( wavelength, obs.getStartTime(), obsGmst[k],
+                                                          network.getDxyz( obs.getStaid1(), obs.getStaid2() ) );
+                } else {
+                    flux[k] = 1e-3;
+                }
+            }
+
+            if ( flux[k] == 0 ) {
+                flux[k] = 1e-3;
+            }
+        }
+    }
+
+    // calculate required observing duration of all remaining observations
+    for ( unsigned long k = 0; k < nMissing; ++k ) {
+        const Observation &thisObservation = observations_[missing[k]];
 
         // get station ids from this baseline
         unsigned long staid1 = thisObservation.getStaid1();
@@ -496,47 +588,24 @@ bool Scan::calcObservationDuration( const Network &network, const std::shared_pt
         const Station &sta2 = network.getStation( staid2 );
         const Baseline &bl = network.getBaseline( staid1, staid2 );
 
-        // get baseline scan start time
-        unsigned int startTime = thisObservation.getStartTime();
-
-        // calculate greenwhich meridian sedirial time
-        double date1 = 2400000.5;
-        double date2 = TimeSystem::mjdStart + static_cast<double>( startTime ) / 86400.0;
-        double gmst = iauGmst82( date1, date2 );
-
-        unsigned int maxDuration = 0;
+        DurationCache::Duration thisDuration;
 
         // loop over each band
-        bool flag_observationRemoved = false;
-        for ( auto &band : mode->getAllBands() ) {
-            double SEFD_src;
-            if ( source->hasFluxInformation( band ) ) {
-                // calculate observed flux density for each band
-                SEFD_src = source->observedFlux( band, startTime, gmst, network.getDxyz( staid1, staid2 ) );
-            } else if ( ObservingMode::sourceBackup[band] == ObservingMode::Backup::internalModel ) {
-                // calculate observed flux density based on model
-                double wavelength = ObservingMode::wavelengths[band];
-                SEFD_src = source->observedFlux_model( wavelength, startTime, gmst, network.getDxyz( staid1, staid2 ) );
-            } else {
-                SEFD_src = 1e-3;
-            }
-
-
-            if ( SEFD_src == 0 ) {
-                SEFD_src = 1e-3;
-            }
+        for ( unsigned long iband = 0; iband < nBands; ++iband ) {
+            unsigned long bandId = bandIds[iband];
+            double SEFD_src = obsFlux[iband * nMissing + k];
 
             // calculate system equivalent flux density for each station
             double el1 = pointingVectorsStart_[*findIdxOfStationId( staid1 )].getEl();
-            double SEFD_sta1 = sta1.getEquip().getSEFD( band, el1 );
+            double SEFD_sta1 = sta1.getEquip().getSEFD( bandId, el1 );
             double el2 = pointingVectorsStart_[*findIdxOfStationId( staid2 )].getEl();
-            double SEFD_sta2 = sta2.getEquip().getSEFD( band, el2 );
+            double SEFD_sta2 = sta2.getEquip().getSEFD( bandId, el2 );
 
             // get minimum required SNR for each station, baseline and source
-            double minSNR_sta1 = sta1.getPARA().minSNR.at( band );
-            double minSNR_sta2 = sta2.getPARA().minSNR.at( band );
-            double minSNR_bl = bl.getParameters().minSNR.at( band );
-            double minSNR_src = source->getPARA().minSNR.at( band );
+            double minSNR_sta1 = sta1.getPARA().minSNR.at( bandId );
+            double minSNR_sta2 = sta2.getPARA().minSNR.at( bandId );
+            double minSNR_bl = bl.getParameters().minSNR.at( bandId );
+            double minSNR_src = source->getPARA().minSNR.at( bandId );
 
             // maximum required minSNR
             double maxminSNR = max( { minSNR_src, minSNR_bl, minSNR_sta1, minSNR_sta2 } );
@@ -550,9 +619,10 @@ bool Scan::calcObservationDuration( const Network &network, const std::shared_pt
             double efficiency = mode->efficiency( sta1.getId(), sta2.getId() );
             double anum = ( maxminSNR / ( SEFD_src * efficiency ) );
             double anu1 = SEFD_sta1 * SEFD_sta2;
-            double anu2 = mode->recordingRate( staid1, staid2, band );
+            double anu2 = mode->recordingRate( staid1, staid2, bandId );
             if ( anu2 == 0 ) {
-                return false;
+                thisDuration.status = DurationCache::Duration::Status::noRecordingRate;
+                break;
             }
             double new_duration = anum * anum * anu1 / anu2 + maxCorSynch;
             new_duration = ceil( new_duration );
@@ -565,25 +635,42 @@ bool Scan::calcObservationDuration( const Network &network, const std::shared_pt
             }
             unsigned int maxScanBl = bl.getParameters().maxScan;
             if ( new_duration_uint > maxScanBl ) {
-                bool scanValid = removeObservation( idxObs, source );
-                if ( !scanValid ) {
-                    return false;
-                }
-                flag_observationRemoved = true;
+                thisDuration.status = DurationCache::Duration::Status::tooLong;
                 break;
             }
 
             // change maxDuration if it is higher for this band
-            if ( new_duration_uint > maxDuration ) {
-                maxDuration = new_duration_uint;
+            if ( new_duration_uint > thisDuration.duration ) {
+                thisDuration.duration = new_duration_uint;
             }
         }
 
-        // if you have not removed the baseline increment counter and set the baseline scan duration
-        if ( !flag_observationRemoved ) {
-            ++idxObs;
-            thisObservation.setObservingTime( maxDuration );
+        blid2duration[thisObservation.getBlid()] = thisDuration;
+        if ( cache != nullptr ) {
+            cache->store( keys[missing[k]], thisDuration );
+        }
+    }
+
+    // loop over all observed baselines
+    int idxObs = 0;
+    while ( idxObs < observations_.size() ) {
+        auto &thisObservation = observations_[idxObs];
+        const DurationCache::Duration &thisDuration = blid2duration[thisObservation.getBlid()];
+
+        if ( thisDuration.status == DurationCache::Duration::Status::noRecordingRate ) {
+            return false;
+        }
+        if ( thisDuration.status == DurationCache::Duration::Status::tooLong ) {
+            bool scanValid = removeObservation( idxObs, source );
+            if ( !scanValid ) {
+                return false;
+            }
+            continue;
         }
+
+        // if you have not removed the baseline increment counter and set the baseline scan duration
+        ++idxObs;
+        thisObservation.setObservingTime( thisDuration.duration );
     }
 
     if ( source->getPARA().forceSameObservingDuration ) {
@@ -753,13 +840,32 @@ bool Scan::scanDuration( const Network &network, const shared_ptr<const Abstract
 }
 
 
-boost::optional<unsigned long> Scan::findIdxOfStationId( unsigned long id ) const noexcept {
-    for ( unsigned long idx = 0; idx < nsta_; ++idx ) {
-        if ( pointingVectorsStart_[idx].getStaid() == id ) {
-            return idx;
-        }
+void Scan::updateStationLookup() noexcept {
+    unsigned long maxStaid = 0;
+    for ( const auto &pv : pointingVectorsStart_ ) {
+        maxStaid = max( maxStaid, pv.getStaid() );
     }
-    return boost::none;
+
+    staid2idx_.assign( pointingVectorsStart_.empty() ? 0 : maxStaid + 1, -1 );
+    stationMask_.assign( maxStaid / 64 + 1, 0 );
+    for ( int idx = 0; idx < pointingVectorsStart_.size(); ++idx ) {
+        unsigned long staid = pointingVectorsStart_[idx].getStaid();
+        staid2idx_[staid] = idx;
+        stationMask_[staid / 64] |= uint64_t{ 1 } << ( staid % 64 );
+    }
+}
+
+
+vector<uint64_t> Scan::stationMask( const std::vector<unsigned long> &ids ) noexcept {
+    unsigned long maxStaid = 0;
+    for ( unsigned long staid : ids ) {
+        maxStaid = max( maxStaid, staid );
+    }
+    vector<uint64_t> mask( maxStaid / 64 + 1, 0 );
+    for ( unsigned long staid : ids ) {
+        mask[staid / 64] |= uint64_t{ 1 } << ( staid % 64 );
+    }
+    return mask;
 }
 
 
@@ -792,6 +898,12 @@ double Scan::calcScore_idleTime( const std::vector<double> &idleScore ) const no
 }
 
 double Scan::calcScore_closures( unsigned long nclosures_max, const std::shared_ptr<const AbstractSource> &source) const noexcept{
+    return calcScore_closures( nsta_, nclosures_max, source );
+}
+
+
+double Scan::calcScore_closures( unsigned long nsta, unsigned long nclosures_max,
+                                 const std::shared_ptr<const AbstractSource> &source ) noexcept {
     double score = 0;
     unsigned long nClosures = source->getNClosures();
     if (nClosures >= WeightFactors::maxClosures){
@@ -799,10 +911,10 @@ double Scan::calcScore_closures( unsigned long nclosures_max, const std::shared_
     }
 
     unsigned long closures;
-    if (nsta_ <= 2){
+    if (nsta <= 2){
         closures = 0;
     }else{
-        closures = (nsta_-1)*(nsta_-2)/2 + nsta_ * (nsta_ -3) / 2;
+        closures = (nsta-1)*(nsta-2)/2 + nsta * (nsta -3) / 2;
     }
 
     score = static_cast<double>(closures) / static_cast<double>(nclosures_max);
@@ -961,6 +1073,18 @@ bool Scan::rigorousUpdate( Network &network, const std::shared_ptr<const Abstrac
             continue;
         }
 
+        // check if no satellite is too close to the pointing direction
+        scanValid = rigorousSatelliteAvoidance( network, source, stationRemoved );
+        if ( !scanValid ) {
+#ifdef VIESCHEDPP_LOG
+            if ( Flags::logTrace ) BOOST_LOG_TRIVIAL( trace ) << "scan " << this->printId() << " no longer valid";
+#endif
+            return scanValid;
+        }
+        if ( stationRemoved ) {
+            continue;
+        }
+
         // check if end position can be reached
         scanValid = rigorousScanCanReachEndposition( network, source, endposition, stationRemoved );
         if ( !scanValid ) {
@@ -1018,7 +1142,7 @@ bool Scan::rigorousSlewtime( Network &network, const std::shared_ptr<const Abstr
 
             // calculate az, el for pointing vector for previouse time
             pv.setTime( oldSlewEnd );
-            thisStation.calcAzEl_rigorous( source, pv );
+            thisStation.calcAzEl_tracking( source, pv );
             if ( !thisStation.isVisible( pv, source->getPARA().minElevation ) ) {
                 scanValid = removeStation( ista, source );
                 if ( !scanValid ) {
@@ -1181,7 +1305,7 @@ bool Scan::rigorousScanVisibility( Network &network, const std::shared_ptr<const
             // check if there is no change in slew direction (no change in azimuth ambigurity)
             double oldAz = moving_pv.getAz();
             moving_pv.setTime( time );
-            thisStation.calcAzEl_rigorous( source, moving_pv );
+            thisStation.calcAzEl_tracking( source, moving_pv );
             thisStation.getCableWrap().unwrapAzNearAz( moving_pv, oldAz );
             double newAz = moving_pv.getAz();
 
@@ -1206,7 +1330,7 @@ bool Scan::rigorousScanVisibility( Network &network, const std::shared_ptr<const
         // check if source is visible at scan end time
         double oldAz = moving_pv.getAz();
         moving_pv.setTime( scanEnd );
-        thisStation.calcAzEl_rigorous( source, moving_pv );
+        thisStation.calcAzEl_tracking( source, moving_pv );
         thisStation.getCableWrap().unwrapAzNearAz( moving_pv, oldAz );
         double newAz = moving_pv.getAz();
 
@@ -1277,6 +1401,31 @@ bool Scan::rigorousSunDistance( const Network &network, const std::shared_ptr<co
     return valid;
 }
 
+bool Scan::rigorousSatelliteAvoidance( const Network &network, const std::shared_ptr<const AbstractSource> &thisSource,
+                                       bool &stationRemoved ) {
+    if ( !AvoidSatellites::isActive() ) {
+        return true;
+    }
+    int ista = 0;
+    bool valid = true;
+    while ( ista < nsta_ ) {
+        const PointingVector &pvStart = pointingVectorsStart_[ista];
+        const PointingVector &pvEnd = pointingVectorsEnd_[ista];
+        const Station &thisStation = network.getStation( pvStart.getStaid() );
+
+        if ( AvoidSatellites::isTooClose( thisStation, thisSource, pvStart, pvEnd ) ) {
+            stationRemoved = true;
+            valid = removeStation( ista, thisSource );
+            if ( !valid ) {
+                return valid;
+            }
+            continue;
+        }
+        ++ista;
+    }
+    return valid;
+}
+
 bool Scan::rigorousSourceVelocity( Network &network, const shared_ptr<const AbstractSource> &source ) {
     int ista = 0;
     bool valid = true;
@@ -1310,7 +1459,7 @@ bool Scan::rigorousSourceVelocity( Network &network, const shared_ptr<const Abst
         for ( unsigned int time = scanStart + dt; time < scanEndLoop; time += dt ) {
             double oldAz = moving_pv_before.getAz();
             moving_after.setTime( time );
-            thisStation.calcAzEl_rigorous( source, moving_after );
+            thisStation.calcAzEl_tracking( source, moving_after );
             thisStation.getCableWrap().unwrapAzNearAz( moving_after, oldAz );
 
             unsigned int slewTimeTracking = thisStation.getAntenna().slewTimeTracking( moving_pv_before, moving_after );
@@ -1333,7 +1482,7 @@ bool Scan::rigorousSourceVelocity( Network &network, const shared_ptr<const Abst
         unsigned int time = scanEnd;
         double oldAz = moving_pv_before.getAz();
         moving_after.setTime( time );
-        thisStation.calcAzEl_rigorous( source, moving_after );
+        thisStation.calcAzEl_tracking( source, moving_after );
         thisStation.getCableWrap().unwrapAzNearAz( moving_after, oldAz );
 
         unsigned int slewTimeTracking = thisStation.getAntenna().slewTimeTracking( moving_pv_before, moving_after );
@@ -1419,6 +1568,7 @@ void Scan::addTagalongStation( const PointingVector &pv_start, const PointingVec
     pointingVectorsStart_.push_back( pv_start );
     pointingVectorsEnd_.push_back( pv_end );
     ++nsta_;
+    updateStationLookup();
     for ( const auto &any : observations ) {
 #ifdef VIESCHEDPP_LOG
         if ( Flags::logTrace )
@@ -1607,6 +1757,119 @@ void Scan::calcScore_subnetting( const std::vector<double> &astas, const std::ve
 }
 
 
+double Scan::calcScoreUpperBound( const std::vector<unsigned long> &staids, ScanType type, const Network &network,
+                                  const std::shared_ptr<const AbstractSource> &source,
+                                  const std::vector<double> &idleScore ) noexcept {
+    unsigned long nsta = staids.size();
+    double nmaxsta = network.getNSta();
+    double nmaxbl = network.getNBls();
+    // at most all baselines between the current stations are observed, all average and elevation/declination
+    // dependent scores are at most one per station/baseline
+    double nbl = nsta * ( nsta - 1 ) / 2;
+    double this_score = 0;
+
+    if ( WeightFactors::weightNumberOfObservations != 0 ) {
+        this_score += nbl / nmaxbl * WeightFactors::weightNumberOfObservations;
+    }
+    if ( WeightFactors::weightAverageSources != 0 ) {
+        this_score += nbl / nmaxbl * WeightFactors::weightAverageSources;
+    }
+    if ( WeightFactors::weightAverageStations != 0 ) {
+        this_score += WeightFactors::weightAverageStations;
+    }
+    if ( WeightFactors::weightAverageBaselines != 0 ) {
+        this_score += nbl * WeightFactors::weightAverageBaselines;
+    }
+    if ( WeightFactors::weightIdleTime != 0 ) {
+        double idle = 0;
+        for ( unsigned long staid : staids ) {
+            idle += idleScore[staid];
+        }
+        this_score += idle * WeightFactors::weightIdleTime;
+    }
+    if ( WeightFactors::weightClosures != 0 ) {
+        this_score += calcScore_closures( nsta, network.getNClosures_max(), source ) * WeightFactors::weightClosures;
+    }
+    if ( WeightFactors::weightDeclination != 0 ) {
+        this_score += nbl / nmaxbl * WeightFactors::weightDeclination;
+    }
+    if ( WeightFactors::weightLowElevation != 0 ) {
+        this_score += nsta / nmaxsta * WeightFactors::weightLowElevation;
+    }
+    if ( WeightFactors::weightSkyCoverage != 0 ) {
+        this_score += nsta / nmaxsta * WeightFactors::weightSkyCoverage;
+    }
+
+    // same factors as in calcScore_secondPart, minimum repeat factor is always smaller than one and ignored
+    const auto &para = source->getPARA();
+    if ( para.weight < 0 ) {
+        return std::numeric_limits<double>::infinity();
+    }
+    if ( para.tryToFocusIfObservedOnce && source->getNscans() > 0 ) {
+        double factor = *para.tryToFocusFactor;
+        if ( *para.tryToFocusOccurrency != AbstractSource::TryToFocusOccurrency::once ) {
+            factor *= source->getNscans();
+        }
+        if ( *para.tryToFocusType == AbstractSource::TryToFocusType::additive ) {
+            this_score += factor;
+        } else if ( factor >= 0 ) {
+            this_score *= factor;
+        } else {
+            return std::numeric_limits<double>::infinity();
+        }
+    }
+    if ( scanSequence_flag && type == ScanType::standard ) {
+        if ( scanSequence_target.find( scanSequence_modulo ) != scanSequence_target.end() ) {
+            const vector<unsigned long> &target = scanSequence_target[scanSequence_modulo];
+            if ( find( target.begin(), target.end(), source->getId() ) != target.end() ) {
+                this_score *= 1e8;
+            } else {
+                if ( target.size() == 1 ) {
+                    this_score /= 1e8;
+                } else {
+                    this_score = 0;
+                }
+            }
+        }
+    }
+    this_score *= para.weight;
+
+    // stations or baselines with weight smaller than one might be removed later
+    for ( unsigned long i = 0; i < nsta; ++i ) {
+        unsigned long staid1 = staids[i];
+        double weight = network.getStation( staid1 ).getPARA().weight;
+        if ( weight < 0 ) {
+            return std::numeric_limits<double>::infinity();
+        }
+        if ( weight > 1 ) {
+            this_score *= weight;
+        }
+        for ( unsigned long j = i + 1; j < nsta; ++j ) {
+            unsigned long staid2 = staids[j];
+            double weightBl = network.getBaseline( staid1, staid2 ).getParameters().weight;
+            if ( weightBl < 0 ) {
+                return std::numeric_limits<double>::infinity();
+            }
+            if ( weightBl > 1 ) {
+                this_score *= weightBl;
+            }
+        }
+    }
+
+    return this_score;
+}
+
+
+bool Scan::scoreUpperBoundValid( ScanType type ) noexcept {
+    return type == ScanType::standard && WeightFactors::weightDuration == 0 &&
+           WeightFactors::weightNumberOfObservations >= 0 && WeightFactors::weightAverageSources >= 0 &&
+           WeightFactors::weightAverageStations >= 0 && WeightFactors::weightAverageBaselines >= 0 &&
+           WeightFactors::weightIdleTime >= 0 && WeightFactors::weightClosures >= 0 &&
+           WeightFactors::weightDeclination >= 0 && WeightFactors::weightLowElevation >= 0 &&
+           WeightFactors::weightSkyCoverage >= 0;
+}
+
+
 void Scan::calcScore( unsigned int minTime, unsigned int maxTime, const Network &network,
                       const std::shared_ptr<const AbstractSource> &source, double hiscore, bool subnetting ) {
     double this_score = calcScore_firstPart( vector<double>(), vector<double>(), vector<double>(), minTime, maxTime,
@@ -1904,12 +2167,16 @@ boost::optional<Scan> Scan::copyScan( const std::vector<unsigned long> &ids,
     pv.reserve( ids.size() );
     ScanTimes t = times_;
     vector<Observation> obs;
+    vector<uint64_t> mask = stationMask( ids );
+    auto contains = [&mask]( unsigned long id ) {
+        return id / 64 < mask.size() && ( mask[id / 64] >> ( id % 64 ) ) & 1u;
+    };
 
     int counter = 0;
     // add all found pointing vectors to new pointing vector vector
     for ( auto &any : pointingVectorsStart_ ) {
         unsigned long id = any.getStaid();
-        if ( find( ids.begin(), ids.end(), id ) != ids.end() ) {
+        if ( contains( id ) ) {
             pv.push_back( pointingVectorsStart_[counter] );
         }
         ++counter;
@@ -1923,7 +2190,7 @@ boost::optional<Scan> Scan::copyScan( const std::vector<unsigned long> &ids,
     if ( !source->getPARA().requiredStations.empty() ) {
         const vector<unsigned long> &rsta = source->getPARA().requiredStations;
         for ( auto &thisRequiredStationId : rsta ) {
-            if ( find( ids.begin(), ids.end(), thisRequiredStationId ) == ids.end() ) {
+            if ( !contains( thisRequiredStationId ) ) {
                 return boost::none;
             }
         }
@@ -1932,7 +2199,7 @@ boost::optional<Scan> Scan::copyScan( const std::vector<unsigned long> &ids,
     // remove times of pointingVectorsStart_(original scan) which are not found (not part of pv)
     for ( auto i = static_cast<int>( nsta_ - 1 ); i >= 0; --i ) {
         unsigned long thisId = pointingVectorsStart_[i].getStaid();
-        if ( find( ids.begin(), ids.end(), thisId ) == ids.end() ) {
+        if ( !contains( thisId ) ) {
             t.removeElement( i );
         }
     }
@@ -1943,8 +2210,7 @@ boost::optional<Scan> Scan::copyScan( const std::vector<unsigned long> &ids,
         unsigned long staid1 = thisBl.getStaid1();
         unsigned long staid2 = thisBl.getStaid2();
 
-        if ( find( ids.begin(), ids.end(), staid1 ) != ids.end() &&
-             find( ids.begin(), ids.end(), staid2 ) != ids.end() ) {
+        if ( contains( staid1 ) && contains( staid2 ) ) {
             obs.push_back( iobs );
         }
     }
@@ -1956,6 +2222,67 @@ boost::optional<Scan> Scan::copyScan( const std::vector<unsigned long> &ids,
 }
 
 
+bool Scan::isValidSubset( const std::vector<unsigned long> &ids,
+                          const std::shared_ptr<const AbstractSource> &source ) const noexcept {
+    vector<uint64_t> mask = stationMask( ids );
+    auto contains = [&mask]( unsigned long id ) {
+        return id / 64 < mask.size() && ( mask[id / 64] >> ( id % 64 ) ) & 1u;
+    };
+
+    // same checks as in copyScan
+    unsigned long npv = count_if( pointingVectorsStart_.begin(), pointingVectorsStart_.end(),
+                                  [&]( const PointingVector &pv ) { return contains( pv.getStaid() ); } );
+    if ( npv < source->getPARA().minNumberOfStations ) {
+        return false;
+    }
+    for ( auto &thisRequiredStationId : source->getPARA().requiredStations ) {
+        if ( !contains( thisRequiredStationId ) ) {
+            return false;
+        }
+    }
+    return any_of( observations_.begin(), observations_.end(), [&]( const Observation &obs ) {
+        return contains( obs.getStaid1() ) && contains( obs.getStaid2() );
+    } );
+}
+
+
+void Scan::copySubset( const std::vector<unsigned long> &ids, Scan &target ) const noexcept {
+    vector<uint64_t> mask = stationMask( ids );
+    auto contains = [&mask]( unsigned long id ) {
+        return id / 64 < mask.size() && ( mask[id / 64] >> ( id % 64 ) ) & 1u;
+    };
+
+    target.pointingVectorsStart_.clear();
+    for ( const auto &any : pointingVectorsStart_ ) {
+        if ( contains( any.getStaid() ) ) {
+            target.pointingVectorsStart_.push_back( any );
+        }
+    }
+    target.pointingVectorsEnd_.clear();
+
+    target.times_ = times_;
+    for ( auto i = static_cast<int>( nsta_ - 1 ); i >= 0; --i ) {
+        if ( !contains( pointingVectorsStart_[i].getStaid() ) ) {
+            target.times_.removeElement( i );
+        }
+    }
+
+    target.observations_.clear();
+    for ( const auto &any : observations_ ) {
+        if ( contains( any.getStaid1() ) && contains( any.getStaid2() ) ) {
+            target.observations_.push_back( any );
+        }
+    }
+
+    target.nsta_ = target.pointingVectorsStart_.size();
+    target.updateStationLookup();
+    target.srcid_ = srcid_;
+    target.score_ = 0;
+    target.type_ = type_;
+    target.constellation_ = ScanConstellation::subnetting;
+}
+
+
 double Scan::weight_stations( const std::vector<Station> &stations ) {
     double weight = 1;
     for ( const auto &any : pointingVectorsStart_ ) {
@@ -2264,6 +2591,18 @@ std::string Scan::toSkedOutputTimes( const std::shared_ptr<const AbstractSource>
 }
 
 
+void Scan::releaseBuffers( ScanPool &pool ) noexcept {
+    pool.give( std::move( pointingVectorsStart_ ) );
+    pool.give( std::move( pointingVectorsEnd_ ) );
+    pool.give( std::move( observations_ ) );
+    pointingVectorsStart_.clear();
+    pointingVectorsEnd_.clear();
+    observations_.clear();
+    nsta_ = 0;
+    updateStationLookup();
+}
+
+
 void Scan::includesStations( std::vector<char> &flag ) const {
     for ( const auto &pv : pointingVectorsStart_ ) {
         unsigned long staid = pv.getStaid();
@@ -31,14 +31,17 @@
 #include <boost/date_time.hpp>
 #include <boost/format.hpp>
 #include <boost/optional.hpp>
+#include <cstdint>
 #include <iostream>
 #include <limits>
 #include <utility>
 #include <vector>
 
 #include "../Misc/AstrometricCalibratorBlock.h"
+#include "../Misc/AvoidSatellites.h"
 #include "../Misc/CalibratorBlock.h"
 #include "../Misc/DifferentialParallacticAngleBlock.h"
+#include "../Misc/ObjectCounter.h"
 #include "../Misc/ParallacticAngleBlock.h"
 #include "../Misc/StationEndposition.h"
 #include "../Misc/TimeSystem.h"
@@ -47,8 +50,10 @@
 #include "../ObservingMode/Mode.h"
 #include "../Source/AbstractSource.h"
 #include "../Station/Network.h"
+#include "DurationCache.h"
 #include "Observation.h"
 #include "PointingVector.h"
+#include "ScanPool.h"
 #include "ScanTimes.h"
 
 
@@ -174,8 +179,10 @@ class Scan : public VieVS_Object {
      * @param pointingVectors all pointing vectors
      * @param endOfLastScan time information for endtime of last scan for each station in seconds since session start
      * @param type scan type
+     * @param pool released buffers which are reused for observations and end pointing vectors (optional)
      */
-    Scan( std::vector<PointingVector> &pointingVectors, std::vector<unsigned int> &endOfLastScan, ScanType type );
+    Scan( std::vector<PointingVector> &pointingVectors, std::vector<unsigned int> &endOfLastScan, ScanType type,
+          ScanPool *pool = nullptr );
 
 
     /**
@@ -402,10 +409,50 @@ class Scan : public VieVS_Object {
      * @brief finds the index of an station id
      * @author Matthias Schartner
      *
+     * Constant time lookup based on station id to index map
+     *
      * @param id station id
      * @return index
      */
-    boost::optional<unsigned long> findIdxOfStationId( unsigned long id ) const noexcept;
+    boost::optional<unsigned long> findIdxOfStationId( unsigned long id ) const noexcept {
+        if ( id < staid2idx_.size() && staid2idx_[id] >= 0 ) {
+            return static_cast<unsigned long>( staid2idx_[id] );
+        }
+        return boost::none;
+    }
+
+
+    /**
+     * @brief checks if station is part of this scan
+     * @author Matthias Schartner
+     *
+     * @param id station id
+     * @return true if station is part of this scan
+     */
+    bool hasStation( unsigned long id ) const noexcept {
+        return id / 64 < stationMask_.size() && ( stationMask_[id / 64] >> ( id % 64 ) ) & 1u;
+    }
+
+
+    /**
+     * @brief getter for station bitmask
+     * @author Matthias Schartner
+     *
+     * bit (staid % 64) of word (staid / 64) is set if station is part of this scan
+     *
+     * @return station bitmask
+     */
+    const std::vector<uint64_t> &getStationMask() const noexcept { return stationMask_; }
+
+
+    /**
+     * @brief creates station bitmask of a list of station ids
+     * @author Matthias Schartner
+     *
+     * @param ids list of station ids
+     * @return station bitmask
+     */
+    static std::vector<uint64_t> stationMask( const std::vector<unsigned long> &ids ) noexcept;
 
 
     /**
@@ -451,10 +498,11 @@ class Scan : public VieVS_Object {
      * @param network station network
      * @param source observed source
      * @param mode observing mode
+     * @param cache cache of required observing durations (optional)
      * @return true is scan is still valid, otherwise false
      */
     bool calcObservationDuration( const Network &network, const std::shared_ptr<const AbstractSource> &source,
-                                  const std::shared_ptr<const Mode> &mode ) noexcept;
+                                  const std::shared_ptr<const Mode> &mode, DurationCache *cache = nullptr ) noexcept;
 
     /**
      * @brief calculates the average SNR of all observations in this scan
@@ -588,6 +636,39 @@ class Scan : public VieVS_Object {
                                const std::vector<double> &idleScore ) noexcept;
 
 
+    /**
+     * @brief optimistic upper bound of standard score
+     * @author Matthias Schartner
+     *
+     * Only depends on the participating stations, thus it can be calculated before a scan object is created. Stays
+     * valid as long as stations are only removed from the scan and scoreUpperBoundValid() is true.
+     *
+     * @param staids ids of participating stations
+     * @param type scan type
+     * @param network station network
+     * @param source observed source
+     * @param idleScore precalculated vector of extra scores due to long idle time
+     * @return upper bound of score (infinity if no bound is possible)
+     */
+    static double calcScoreUpperBound( const std::vector<unsigned long> &staids, ScanType type,
+                                       const Network &network, const std::shared_ptr<const AbstractSource> &source,
+                                       const std::vector<double> &idleScore ) noexcept;
+
+
+    /**
+     * @brief check if calcScoreUpperBound() is a valid upper bound of the score
+     * @author Matthias Schartner
+     *
+     * The bound is only valid for standard scans, if the duration score is not used and if all other weight factors
+     * are non-negative. Non-negative weight factors also guarantee a non-negative score, which is necessary to ignore
+     * the minimum repeat factor (always smaller than one). Must be updated together with calcScoreUpperBound().
+     *
+     * @param type scan type
+     * @return true if upper bound is valid
+     */
+    static bool scoreUpperBoundValid( ScanType type ) noexcept;
+
+
     /**
      * @brief calc score for high impact scans
      * @author Matthias Schartner
@@ -704,6 +785,31 @@ class Scan : public VieVS_Object {
                                     const std::shared_ptr<const AbstractSource> &source ) const noexcept;
 
 
+    /**
+     * @brief check if copyScan() would create a valid scan
+     * @author Matthias Schartner
+     *
+     * @param ids ids of all stations which should be copied
+     * @param source observed source
+     * @return true if a valid scan can be created with the stations from ids parameter
+     */
+    bool isValidSubset( const std::vector<unsigned long> &ids,
+                        const std::shared_ptr<const AbstractSource> &source ) const noexcept;
+
+
+    /**
+     * @brief copy all stations from parameter ids into an existing scan
+     * @author Matthias Schartner
+     *
+     * Same content as copyScan() but reuses the memory of the target scan (target keeps its id). Used to evaluate
+     * subnetting combinations without creating new scans. The subset has to be valid (see isValidSubset()).
+     *
+     * @param ids ids of all stations which should be copied
+     * @param target scan which is overwritten
+     */
+    void copySubset( const std::vector<unsigned long> &ids, Scan &target ) const noexcept;
+
+
     /**
      * @brief getter for number of observations
      * @author Matthias Schartner
@@ -810,7 +916,7 @@ class Scan : public VieVS_Object {
      *
      * @return total number of created scans
      */
-    static unsigned long numberOfCreatedObjects() { return nextId - 1; }
+    static unsigned long numberOfCreatedObjects() { return nextId.get() - 1; }
 
 
     /**
@@ -941,8 +1047,19 @@ class Scan : public VieVS_Object {
 
     bool noInterception( const std::vector<Scan> &scans, const Network &network );
 
+
+    /**
+     * @brief give pointing vector and observation buffers back to pool
+     * @author Matthias Schartner
+     *
+     * The scan is empty afterwards and must not be used anymore.
+     *
+     * @param pool pool of released buffers
+     */
+    void releaseBuffers( ScanPool &pool ) noexcept;
+
    private:
-    static unsigned long nextId;  ///< next id for this object type
+    static IdCounter nextId;  ///< next id for this object type
 
     unsigned long nsta_;   ///< number of stations in this scan
     unsigned long srcid_;  ///< observed source id
@@ -954,9 +1071,20 @@ class Scan : public VieVS_Object {
     std::vector<PointingVector> pointingVectorsEnd_;    ///< pointing vectors at end of the scan
     std::vector<Observation> observations_;             ///< all observed baselines
 
+    std::vector<int> staid2idx_;         ///< index of pointing vector per station id (-1 if station is not in scan)
+    std::vector<uint64_t> stationMask_;  ///< bitmask of all station ids in this scan
+
     ScanType type_;                    ///< type of the scan
     ScanConstellation constellation_;  /// scan constellation type
 
+    /**
+     * @brief updates station id to index map and station bitmask
+     * @author Matthias Schartner
+     *
+     * Has to be called whenever pointing vectors are added, removed or reordered
+     */
+    void updateStationLookup() noexcept;
+
     /**
      * @brief rigorous slew time calculation
      * @author Matthias Schartner
@@ -1031,6 +1159,18 @@ class Scan : public VieVS_Object {
     bool rigorousSunDistance( const Network &network, const std::shared_ptr<const AbstractSource> &thisSource );
 
 
+    /**
+     * @brief rigorous check if no satellite of AvoidSatellites comes too close to pointing direction
+     * @author Matthias Schartner
+     *
+     * @param network station network
+     * @param thisSource observed source
+     * @param stationRemoved flag if a station was removed
+     */
+    bool rigorousSatelliteAvoidance( const Network &network, const std::shared_ptr<const AbstractSource> &thisSource,
+                                     bool &stationRemoved );
+
+
     /**
      * @brief rigorous check that source is not moving faster than antenna slew speed
      * @author Matthias Schartner
@@ -1116,6 +1256,19 @@ class Scan : public VieVS_Object {
     double calcScore_closures(unsigned long nclosures_max, const std::shared_ptr<const AbstractSource> &source) const noexcept;
 
 
+    /**
+     * @brief calculte score based on number of independent closure phases and amplitudes
+     * @author Matthias Schartner
+     *
+     * @param nsta number of stations
+     * @param nclosures_max number of theoretically possible independent closure phases and amplitudes
+     * @param source observed source
+     * @return score based on number of independent closure phases and amplitudes
+     */
+    static double calcScore_closures( unsigned long nsta, unsigned long nclosures_max,
+                                      const std::shared_ptr<const AbstractSource> &source ) noexcept;
+
+
     /**
      * @brief mean of the weight factors for each participating station
      * @author Matthias Schartner
@@ -0,0 +1,161 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ScanPool.h
+ * @brief class ScanPool
+ *
+ * @author Matthias Schartner
+ * @date 15.10.2026
+ */
+
+#ifndef SCANPOOL_H
+#define SCANPOOL_H
+
+
+#include <vector>
+
+#include "Observation.h"
+#include "PointingVector.h"
+
+
+namespace VieVS {
+
+/**
+ * @class ScanPool
+ * @brief storage of released scan buffers which are reused by the scans of the following subcons
+ *
+ * Each scan selection creates and discards thousands of scans. Instead of returning the pointing vector and
+ * observation buffers of these scans to the global heap, a subcon gives them back to the pool of its scheduler when
+ * it is destroyed and the next subcon takes them again. Selected scans are moved out of the subcon before and are not
+ * affected.
+ *
+ * Each scheduler owns its own pool, therefore multi scheduling threads do not compete for heap memory. A pool must
+ * only be used by one thread at a time.
+ *
+ * @author Matthias Schartner
+ * @date 15.10.2026
+ */
+class ScanPool {
+   public:
+    static unsigned long maxBuffers;  ///< maximum number of stored buffers per type
+
+
+    /**
+     * @brief take an empty pointing vector buffer
+     * @author Matthias Schartner
+     *
+     * @return empty buffer (with reserved memory if available)
+     */
+    std::vector<PointingVector> takePointingVectors() noexcept { return take( pointingVectors_ ); }
+
+
+    /**
+     * @brief take an empty observation buffer
+     * @author Matthias Schartner
+     *
+     * @return empty buffer (with reserved memory if available)
+     */
+    std::vector<Observation> takeObservations() noexcept { return take( observations_ ); }
+
+
+    /**
+     * @brief give back pointing vector buffer
+     * @author Matthias Schartner
+     *
+     * @param buffer released buffer
+     */
+    void give( std::vector<PointingVector> &&buffer ) noexcept { give( pointingVectors_, std::move( buffer ) ); }
+
+
+    /**
+     * @brief give back observation buffer
+     * @author Matthias Schartner
+     *
+     * @param buffer released buffer
+     */
+    void give( std::vector<Observation> &&buffer ) noexcept { give( observations_, std::move( buffer ) ); }
+
+
+    /**
+     * @brief getter for number of reused buffers
+     * @author Matthias Schartner
+     *
+     * @return number of reused buffers
+     */
+    unsigned long getReused() const noexcept { return reused_; }
+
+
+    /**
+     * @brief getter for number of requested buffers
+     * @author Matthias Schartner
+     *
+     * @return number of requested buffers
+     */
+    unsigned long getRequested() const noexcept { return requested_; }
+
+
+   private:
+    std::vector<std::vector<PointingVector>> pointingVectors_;  ///< released pointing vector buffers
+    std::vector<std::vector<Observation>> observations_;        ///< released observation buffers
+
+    unsigned long reused_ = 0;     ///< number of reused buffers
+    unsigned long requested_ = 0;  ///< number of requested buffers
+
+
+    /**
+     * @brief take an empty buffer
+     * @author Matthias Schartner
+     *
+     * @tparam T buffer element type
+     * @param buffers released buffers
+     * @return empty buffer (with reserved memory if available)
+     */
+    template <typename T>
+    std::vector<T> take( std::vector<std::vector<T>> &buffers ) noexcept {
+        ++requested_;
+        if ( buffers.empty() ) {
+            return std::vector<T>();
+        }
+        ++reused_;
+        std::vector<T> buffer = std::move( buffers.back() );
+        buffers.pop_back();
+        return buffer;
+    }
+
+
+    /**
+     * @brief store buffer if it has reserved memory
+     * @author Matthias Schartner
+     *
+     * @tparam T buffer element type
+     * @param buffers released buffers
+     * @param buffer released buffer
+     */
+    template <typename T>
+    void give( std::vector<std::vector<T>> &buffers, std::vector<T> &&buffer ) noexcept {
+        if ( buffer.capacity() == 0 || buffers.size() >= maxBuffers ) {
+            return;
+        }
+        buffer.clear();
+        buffers.push_back( std::move( buffer ) );
+    }
+};
+}  // namespace VieVS
+
+#endif  // SCANPOOL_H
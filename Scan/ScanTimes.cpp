@@ -21,11 +21,11 @@
 
 using namespace std;
 using namespace VieVS;
-unsigned long ScanTimes::nextId = 0;
+IdCounter ScanTimes::nextId{ 0 };
 ScanTimes::AlignmentAnchor ScanTimes::anchor = ScanTimes::AlignmentAnchor::start;
 
 
-ScanTimes::ScanTimes( unsigned int nsta ) : VieVS_Object( nextId++ ) {
+ScanTimes::ScanTimes( unsigned int nsta ) : VieVS_Object( nextId.next() ) {
     endOfLastScan_.resize( nsta );
     endOfFieldSystemTime_.resize( nsta );
     endOfSlewTime_.resize( nsta );
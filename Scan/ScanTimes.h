@@ -31,6 +31,7 @@
 #include <limits>
 #include <vector>
 
+#include "../Misc/ObjectCounter.h"
 #include "../Misc/VieVS_Object.h"
 #include "../Misc/util.h"
 #include "PointingVector.h"
@@ -149,7 +150,7 @@ class ScanTimes : public VieVS_Object {
      * @brief set new id
      * @author Matthias Schartner
      */
-    void giveNewId() { setId( nextId++ ); }
+    void giveNewId() { setId( nextId.next() ); }
 
 
     /**
@@ -563,7 +564,7 @@ class ScanTimes : public VieVS_Object {
 
 
    private:
-    static unsigned long nextId;    ///< next id for this object type
+    static IdCounter nextId;        ///< next id for this object type
     static AlignmentAnchor anchor;  ///< scan alignment anchor
 
     std::vector<unsigned int> endOfLastScan_;         ///< end of last scan
@@ -25,13 +25,72 @@
 
 #include "Subcon.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace std;
 using namespace VieVS;
-unsigned long Subcon::nextId = 0;
+
+namespace {
+/**
+ * @brief reusable scan objects to evaluate subnetting scans without creating them
+ * @author Matthias Schartner
+ */
+struct SubnettingWorkspace {
+    boost::optional<Scan> scan1;     ///< first scan
+    boost::optional<Scan> scan2;     ///< second scan
+    std::vector<unsigned long> ids1;  ///< station ids of first scan
+    std::vector<unsigned long> ids2;  ///< station ids of second scan
+};
+
+
+/**
+ * @brief remove station from scan candidate
+ * @author Matthias Schartner
+ *
+ * Same checks as Scan::removeStation() before observations are constructed.
+ *
+ * @param candidates scan candidates
+ * @param c candidate index
+ * @param r row index of station
+ * @param source observed source
+ * @return true if candidate is still valid
+ */
+bool removeCandidateStation( CandidateTable &candidates, unsigned long c, unsigned long r,
+                             const shared_ptr<const AbstractSource> &source ) noexcept {
+    candidates.removeStation( c, r );
+    if ( candidates.getNSta( c ) < source->getPARA().minNumberOfStations ) {
+        return false;
+    }
+    const vector<unsigned long> &rsta = source->getPARA().requiredStations;
+    return find( rsta.begin(), rsta.end(), candidates.getStaid( r ) ) == rsta.end();
+}
+}  // namespace
+IdCounter Subcon::nextId{ 0 };
+bool Subcon::parallelEvaluation = false;
+unsigned int Subcon::speculativeUpdates = 0;
 
 
-Subcon::Subcon() : VieVS_Object( nextId++ ), nSingleScans_{ 0 }, nSubnettingScans_{ 0 } {}
+Subcon::Subcon() : VieVS_Object( nextId.next() ), nSingleScans_{ 0 }, nSubnettingScans_{ 0 } {}
+
+
+Subcon::~Subcon() {
+    ScanPool *pool = pool_.get();
+    if ( pool == nullptr ) {
+        return;
+    }
+    for ( auto &any : singleScans_ ) {
+        any.releaseBuffers( *pool );
+    }
+    for ( auto &any : subnettingParents_ ) {
+        any.releaseBuffers( *pool );
+    }
+    for ( auto &any : subnettingScans_ ) {
+        any.first.releaseBuffers( *pool );
+        any.second.releaseBuffers( *pool );
+    }
+}
 
 
 void Subcon::addScan( Scan &&scan ) noexcept {
@@ -47,101 +106,122 @@ void Subcon::addScan( Scan &&scan ) noexcept {
 
 
 void Subcon::calcStartTimes( const Network &network, const SourceList &sourceList,
-                             const boost::optional<StationEndposition> &endposition ) noexcept {
+                             const boost::optional<StationEndposition> &endposition, CandidateCache *cache ) noexcept {
 #ifdef VIESCHEDPP_LOG
     if ( Flags::logDebug ) BOOST_LOG_TRIVIAL( debug ) << "subcon " << this->printId() << " calc scan start times";
 #endif
 
-    int i = 0;
-    // loop through all scans
-    while ( i < nSingleScans_ ) {
-        bool scanValid_slew = true;
-        bool scanValid_idle = true;
-        bool scanValid_endposition = true;
-
-        // save maximum idle times
-        vector<unsigned int> maxIdleTimes;
-
-        // current scan
-        Scan &thisScan = singleScans_[i];
-
-        const auto &thisSource = sourceList.getSource( thisScan.getSourceId() );
+    // loop through all candidates
+    unsigned long n = candidates_.size();
+    vector<char> valid( n, true );
+    forEachCandidate( n, [&]( unsigned long c ) {
+        const auto &thisSource = sourceList.getSource( candidates_.getSrcid( c ) );
+        bool scanValid = true;
 
         // loop through all stations
-        int j = 0;
-        while ( j < thisScan.getNSta() ) {
-            unsigned long staid = thisScan.getStationId( j );
+        for ( unsigned long r = candidates_.firstRow( c ); r < candidates_.endRow( c ); ++r ) {
+            if ( !candidates_.isActive( c, r ) ) {
+                continue;
+            }
+            unsigned long staid = candidates_.getStaid( r );
 
             // current station
             const Station &thisSta = network.getStation( staid );
 
             // first scan means no field system, slew and preob time
             if ( thisSta.getPARA().firstScan ) {
-                thisScan.addTimes( j, 0, 0, 0 );
-                ++j;
-                maxIdleTimes.push_back( thisSta.getPARA().maxWait );
+                candidates_.setTimes( r, 0, 0, 0 );
                 continue;
             }
 
             // unwrap azimuth and calculate slewtime
-            thisSta.getCableWrap().calcUnwrappedAz( thisSta.getCurrentPointingVector(),
-                                                    thisScan.referencePointingVector( j ) );
-            auto slewtime = thisSta.slewTime( thisScan.getPointingVector( j ) );
+            PointingVector p = candidates_.pointingVector( c, r );
+            boost::optional<unsigned int> slewtime;
+            if ( cache != nullptr ) {
+                slewtime = cache->unwrapAndSlewTime( thisSta, p );
+            } else {
+                thisSta.getCableWrap().calcUnwrappedAz( thisSta.getCurrentPointingVector(), p );
+                slewtime = thisSta.slewTime( p );
+            }
 
             // look if slewtime is valid, if yes add field system, slew and preob times
             if ( slewtime.is_initialized() ) {
-                maxIdleTimes.push_back( thisSta.getPARA().maxWait );
-                thisScan.addTimes( j, thisSta.getPARA().systemDelay, *slewtime, thisSta.getPARA().preob );
+                candidates_.setAz( r, p.getAz() );
+                candidates_.setTimes( r, thisSta.getPARA().systemDelay, *slewtime, thisSta.getPARA().preob );
             } else {
-                scanValid_slew = thisScan.removeStation( j, thisSource );
-                if ( !scanValid_slew ) {
+                scanValid = removeCandidateStation( candidates_, c, r, thisSource );
+                if ( !scanValid ) {
                     break;  // scan is no longer valid
                 } else {
-                    continue;  // station was removed, continue with next station (do not increment counter!)
+                    continue;  // station was removed, continue with next station
                 }
             }
 
             // look if there is enough time to reach endposition (if there is any) under perfect circumstances
             if ( endposition.is_initialized() ) {
-                const auto &times = thisScan.getTimes();
+                unsigned int observingStart = candidates_.getEndOfSlew( r ) + candidates_.getPreob( r );
 
                 unsigned int minimumScanTime = max( thisSta.getPARA().minScan, thisSource->getPARA().minScan );
 
                 // calc possible endposition time. Assumtion: 5sec slew time, no idle time and minimum scan time
-                int possibleEndpositionTime = times.getObservingTime( j, Timestamp::start ) + minimumScanTime + 5 +
-                                              thisSta.getPARA().systemDelay + thisSta.getPARA().preob;
+                int possibleEndpositionTime = observingStart + minimumScanTime + 5 + thisSta.getPARA().systemDelay +
+                                              thisSta.getPARA().preob;
 
                 // get minimum required endpositon time
                 int requiredEndpositionTime = endposition->requiredEndpositionTime( staid, false );
 
                 // check if there is enough time left
                 if ( possibleEndpositionTime - 5 > requiredEndpositionTime ) {
-                    scanValid_endposition = thisScan.removeStation( j, thisSource );
-                    if ( !scanValid_endposition ) {
+                    scanValid = removeCandidateStation( candidates_, c, r, thisSource );
+                    if ( !scanValid ) {
                         break;  // scan is no longer valid
-                    } else {
-                        continue;  // station was removed, continue with next station (do not increment counter!)
                     }
                 }
             }
-            ++j;
         }
 
-        if ( scanValid_slew && scanValid_endposition ) {
-            scanValid_idle = thisScan.checkIdleTimes( maxIdleTimes, thisSource );
+        // check idle times, same as Scan::checkIdleTimes(): only the station with the latest slew end is removed
+        if ( scanValid && candidates_.getNSta( c ) > 0 ) {
+            unsigned long latest = candidates_.endRow( c );
+            unsigned int latestSlewTime = 0;
+            for ( unsigned long r = candidates_.firstRow( c ); r < candidates_.endRow( c ); ++r ) {
+                if ( !candidates_.isActive( c, r ) ) {
+                    continue;
+                }
+                if ( latest == candidates_.endRow( c ) || candidates_.getEndOfSlew( r ) > latestSlewTime ) {
+                    latest = r;
+                    latestSlewTime = candidates_.getEndOfSlew( r );
+                }
+            }
+            for ( unsigned long r = candidates_.firstRow( c ); r < candidates_.endRow( c ); ++r ) {
+                if ( !candidates_.isActive( c, r ) ) {
+                    continue;
+                }
+                unsigned int dt = latestSlewTime - candidates_.getEndOfSlew( r );
+                if ( dt > network.getStation( candidates_.getStaid( r ) ).getPARA().maxWait ) {
+                    scanValid = removeCandidateStation( candidates_, c, latest, thisSource );
+                    break;
+                }
+            }
         }
 
-        if ( scanValid_slew && scanValid_endposition && scanValid_idle ) {
-            ++i;
-        } else {
+        valid[c] = scanValid;
+    } );
+
 #ifdef VIESCHEDPP_LOG
-            if ( Flags::logDebug )
-                BOOST_LOG_TRIVIAL( debug ) << "scan " << thisScan.printId() << " no longer valid -> removed";
-#endif
-            singleScans_.erase( next( singleScans_.begin(), i ) );
-            --nSingleScans_;
+    if ( Flags::logDebug ) {
+        for ( unsigned long c = 0; c < n; ++c ) {
+            if ( !valid[c] ) {
+                BOOST_LOG_TRIVIAL( debug ) << "subcon " << this->printId() << " scan to source "
+                                           << candidates_.getSrcid( c ) << " no longer valid -> removed";
+            }
         }
     }
+#endif
+
+    // remove invalid candidates, order of remaining candidates is preserved
+    candidates_.compact( valid );
+    candidates_.setStartTimes( true );
 }
 
 
@@ -149,23 +229,10 @@ void Subcon::constructAllBaselines( const Network &network, const SourceList &so
 #ifdef VIESCHEDPP_LOG
     if ( Flags::logDebug ) BOOST_LOG_TRIVIAL( debug ) << "subcon " << this->printId() << " construct all observations";
 #endif
-    int i = 0;
-    while ( i < nSingleScans_ ) {
-        Scan &thisScan = singleScans_[i];
+    evaluateSingleScans( [&]( Scan &thisScan ) {
         const auto &thisSource = sourceList.getSource( thisScan.getSourceId() );
-        bool scanValid = thisScan.constructObservations( network, thisSource );
-        if ( scanValid ) {
-            ++i;
-        } else {
-#ifdef VIESCHEDPP_LOG
-            if ( Flags::logDebug )
-                BOOST_LOG_TRIVIAL( debug )
-                    << "subcon " << this->printId() << " scan " << thisScan.printId() << " no longer valid -> removed";
-#endif
-            --nSingleScans_;
-            singleScans_.erase( next( singleScans_.begin(), i ) );
-        }
-    }
+        return thisScan.constructObservations( network, thisSource );
+    } );
 }
 
 
@@ -175,10 +242,7 @@ void Subcon::updateAzEl( const Network &network, const SourceList &sourceList )
         BOOST_LOG_TRIVIAL( debug ) << "subcon " << this->printId() << " update azimuth and elevation";
 #endif
 
-    int i = 0;
-    while ( i < nSingleScans_ ) {
-        auto &thisScan = singleScans_[i];
-
+    evaluateSingleScans( [&]( Scan &thisScan ) {
         const auto &thisSource = sourceList.getSource( thisScan.getSourceId() );
         bool scanValid_slew = true;
         bool scanValid_idle = true;
@@ -218,43 +282,23 @@ void Subcon::updateAzEl( const Network &network, const SourceList &sourceList )
             scanValid_idle = thisScan.checkIdleTimes( maxIdleTimes, sourceList.getSource( thisScan.getSourceId() ) );
         }
 
-        if ( !scanValid_slew || !scanValid_idle ) {
-#ifdef VIESCHEDPP_LOG
-            if ( Flags::logDebug )
-                BOOST_LOG_TRIVIAL( debug )
-                    << "subcon " << this->printId() << " scan " << thisScan.printId() << " no longer valid -> removed";
-#endif
-            singleScans_.erase( next( singleScans_.begin(), i ) );
-            --nSingleScans_;
-        } else {
-            ++i;
-        }
-    }
+        return scanValid_slew && scanValid_idle;
+    } );
 }
 
 
 void Subcon::calcAllBaselineDurations( const Network &network, const SourceList &sourceList,
-                                       const std::shared_ptr<const Mode> &mode ) noexcept {
+                                       const std::shared_ptr<const Mode> &mode, DurationCache *cache ) noexcept {
 #ifdef VIESCHEDPP_LOG
     if ( Flags::logDebug ) BOOST_LOG_TRIVIAL( debug ) << "subcon " << this->printId() << " calc observing durations";
 #endif
 
-    int i = 0;
-    while ( i < nSingleScans_ ) {
-        Scan &thisScan = singleScans_[i];
-        bool scanValid =
-            thisScan.calcObservationDuration( network, sourceList.getSource( thisScan.getSourceId() ), mode );
-        if ( scanValid ) {
-            ++i;
-        } else {
-#ifdef VIESCHEDPP_LOG
-            if ( Flags::logDebug )
-                BOOST_LOG_TRIVIAL( debug )
-                    << "subcon " << this->printId() << " scan " << thisScan.printId() << " no longer valid -> removed";
-#endif
-            --nSingleScans_;
-            singleScans_.erase( next( singleScans_.begin(), i ) );
-        }
+    evaluateSingleScans( [&]( Scan &thisScan ) {
+        return thisScan.calcObservationDuration( network, sourceList.getSource( thisScan.getSourceId() ), mode,
+                                                 cache );
+    } );
+    if ( cache != nullptr ) {
+        cache->flush();
     }
 }
 
@@ -265,10 +309,8 @@ void Subcon::calcAllScanDurations( const Network &network, const SourceList &sou
     if ( Flags::logDebug ) BOOST_LOG_TRIVIAL( debug ) << "subcon " << this->printId() << " calc scan durations";
 #endif
     // loop through all scans
-    int i = 0;
-    while ( i < nSingleScans_ ) {
-        // current scan and source
-        Scan &thisScan = singleScans_[i];
+    evaluateSingleScans( [&]( Scan &thisScan ) {
+        // current source
         const auto &thisSource = sourceList.getSource( thisScan.getSourceId() );
 
         // calculate scan durations and check if they are valid
@@ -305,18 +347,8 @@ void Subcon::calcAllScanDurations( const Network &network, const SourceList &sou
             }
         }
 
-        if ( scanValid_scanDuration && scanValid_endposition ) {
-            ++i;
-        } else {
-#ifdef VIESCHEDPP_LOG
-            if ( Flags::logDebug )
-                BOOST_LOG_TRIVIAL( debug )
-                    << "subcon " << this->printId() << " scan " << thisScan.printId() << " no longer valid -> removed";
-#endif
-            --nSingleScans_;
-            singleScans_.erase( next( singleScans_.begin(), i ) );
-        }
-    }
+        return scanValid_scanDuration && scanValid_endposition;
+    } );
 }
 
 
@@ -333,11 +365,7 @@ void Subcon::createSubnettingScans( const std::shared_ptr<Subnetting> &subnettin
     if ( Flags::logDebug ) BOOST_LOG_TRIVIAL( debug ) << "subcon " << this->printId() << " create subnetting scans";
 #endif
 
-    subnettingScans_.clear();
-    vector<unsigned long> sourceIds( nSingleScans_ );
-    for ( int i = 0; i < nSingleScans_; ++i ) {
-        sourceIds[i] = singleScans_[i].getSourceId();
-    }
+    clearSubnettingScans();
 
     unsigned long availableSta = 0;
     for ( const auto &any : network.getStations() ) {
@@ -346,16 +374,35 @@ void Subcon::createSubnettingScans( const std::shared_ptr<Subnetting> &subnettin
         }
     }
 
+    // index of first single source scan per source id and number of words of station masks
+    vector<long> srcid2idx( sourceList.getNSrc(), -1 );
+    unsigned long maxStaid = 0;
+    for ( unsigned long i = 0; i < nSingleScans_; ++i ) {
+        const Scan &thisScan = singleScans_[i];
+        if ( srcid2idx[thisScan.getSourceId()] == -1 ) {
+            srcid2idx[thisScan.getSourceId()] = static_cast<long>( i );
+        }
+        for ( int idx = 0; idx < thisScan.getNSta(); ++idx ) {
+            maxStaid = max( maxStaid, thisScan.getStationId( idx ) );
+        }
+    }
+    nMaskWords_ = maxStaid / 64 + 1;
+
     for ( int i = 0; i < nSingleScans_; ++i ) {
-        unsigned long firstSrcId = sourceIds[i];
         Scan &first = singleScans_[i];
+        unsigned long firstSrcId = first.getSourceId();
         const vector<unsigned long> &secondSrcIds = subnetting->getSubnettingSrcIds().at( firstSrcId );
         for ( unsigned long secondSrcId : secondSrcIds ) {
-            auto it = find( sourceIds.begin(), sourceIds.end(), secondSrcId );
-            if ( it != sourceIds.end() ) {
-                long srcid = distance( sourceIds.begin(), it );
+            if ( srcid2idx[secondSrcId] >= 0 ) {
+                auto srcid = static_cast<unsigned long>( srcid2idx[secondSrcId] );
                 Scan &second = singleScans_[srcid];
 
+                // time difference between scans does not depend on station split
+                if ( util::absDiff( first.getTimes().getScanTime( Timestamp::end ),
+                                    second.getTimes().getScanTime( Timestamp::end ) ) > 600 ) {
+                    continue;
+                }
+
                 vector<unsigned long> uniqueSta1;
                 vector<unsigned long> uniqueSta2;
                 vector<unsigned long> intersection;
@@ -364,7 +411,7 @@ void Subcon::createSubnettingScans( const std::shared_ptr<Subnetting> &subnettin
                     const PointingVector &pv = first.getPointingVector( idx );
                     unsigned long staid = pv.getStaid();
 
-                    if ( !second.findIdxOfStationId( staid ) ) {
+                    if ( !second.hasStation( staid ) ) {
                         uniqueSta1.push_back( staid );
                     } else {
                         intersection.push_back( staid );
@@ -374,7 +421,7 @@ void Subcon::createSubnettingScans( const std::shared_ptr<Subnetting> &subnettin
                     const PointingVector &pv = second.getPointingVector( idx );
                     unsigned long staid = pv.getStaid();
 
-                    if ( !first.findIdxOfStationId( staid ) ) {
+                    if ( !first.hasStation( staid ) ) {
                         uniqueSta2.push_back( staid );
                     }
                 }
@@ -404,43 +451,50 @@ void Subcon::createSubnettingScans( const std::shared_ptr<Subnetting> &subnettin
                         }
                         if ( scan1sta.size() >= sourceList.getSource( firstSrcId )->getPARA().minNumberOfStations &&
                              scan2sta.size() >= sourceList.getSource( secondSrcId )->getPARA().minNumberOfStations ) {
-                            unsigned int firstTime = first.getTimes().getScanTime( Timestamp::end );
-                            unsigned int secondTime = second.getTimes().getScanTime( Timestamp::end );
-
-                            if ( util::absDiff( firstTime, secondTime ) > 600 ) {
+                            if ( !first.isValidSubset( scan1sta, sourceList.getSource( firstSrcId ) ) ) {
                                 continue;
                             }
-
-                            boost::optional<Scan> new_first =
-                                first.copyScan( scan1sta, sourceList.getSource( firstSrcId ) );
-                            if ( !new_first ) {
-                                continue;
-                            }
-
-                            boost::optional<Scan> new_second =
-                                second.copyScan( scan2sta, sourceList.getSource( secondSrcId ) );
-                            if ( !new_second ) {
+                            if ( !second.isValidSubset( scan2sta, sourceList.getSource( secondSrcId ) ) ) {
                                 continue;
                             }
 
 #ifdef VIESCHEDPP_LOG
                             if ( Flags::logDebug )
                                 BOOST_LOG_TRIVIAL( debug )
-                                    << "subcon " << this->printId() << " add subnetting scans with "
-                                    << new_first->printId() << " and " << new_second->printId();
+                                    << "subcon " << this->printId() << " add subnetting scans with subsets of "
+                                    << first.printId() << " and " << second.printId();
 #endif
 
+                            // only store station mask of first scan, scans are created if required
+                            SubnettingCandidate candidate;
+                            candidate.parent1 = static_cast<unsigned long>( i );
+                            candidate.parent2 = srcid;
+                            candidate.maskOffset = subnettingMasks_.size();
+                            subnettingMasks_.resize( subnettingMasks_.size() + nMaskWords_, 0 );
+                            for ( unsigned long staid : scan1sta ) {
+                                subnettingMasks_[candidate.maskOffset + staid / 64] |= uint64_t{ 1 }
+                                                                                       << ( staid % 64 );
+                            }
+                            subnettingCandidates_.push_back( candidate );
                             ++nSubnettingScans_;
-                            pair<Scan, Scan> tmp = make_pair( move( *new_first ), move( *new_second ) );
-                            //                            tmp.first = ;
-                            //                            tmp.second = ;
-                            subnettingScans_.push_back( move( tmp ) );
                         }
                     } while ( next_permutation( std::begin( data ), std::end( data ) ) );
                 }
             }
         }
     }
+
+    // subnetting scans are subsets of the current single source scans -> keep copy of all referenced parents
+    vector<long> parentIdx( nSingleScans_, -1 );
+    for ( auto &candidate : subnettingCandidates_ ) {
+        for ( unsigned long *parent : { &candidate.parent1, &candidate.parent2 } ) {
+            if ( parentIdx[*parent] == -1 ) {
+                parentIdx[*parent] = static_cast<long>( subnettingParents_.size() );
+                subnettingParents_.push_back( singleScans_[*parent] );
+            }
+            *parent = static_cast<unsigned long>( parentIdx[*parent] );
+        }
+    }
 }
 
 
@@ -451,32 +505,58 @@ void Subcon::generateScore( const Network &network, const SourceList &sourceList
 
     precalcScore( network, sourceList );
     //    unsigned long nmaxsta = stations.size();
+    // there is at most one single source scan per source -> each sky coverage cache is only accessed by one thread
     vector<unordered_map<unsigned long, double>> staids2skyCoverageScores( sourceList.getNSrc() );
-    for ( auto &thisScan : singleScans_ ) {
+    forEachCandidate( nSingleScans_, [&]( unsigned long i ) {
+        Scan &thisScan = singleScans_[i];
         unsigned long srcid = thisScan.getSourceId();
         unordered_map<unsigned long, double> &staids2skyCoverageScore = staids2skyCoverageScores[srcid];
         const auto &thisSource = sourceList.getSource( srcid );
         thisScan.calcScore( astas_, asrcs_, abls_, minRequiredTime_, maxRequiredTime_, network, thisSource,
                             staids2skyCoverageScore, idle_ );
-    }
+    } );
+
+    // subnetting scans are evaluated in reusable scan objects (one pair per thread) without creating them
+#ifdef _OPENMP
+    // serial fallback might run inside an outer parallel region -> thread number is only valid in parallel mode
+    bool parallel = candidatesInParallel( nSubnettingScans_ );
+    vector<SubnettingWorkspace> workspaces( parallel ? static_cast<unsigned long>( omp_get_max_threads() ) : 1 );
+#else
+    vector<SubnettingWorkspace> workspaces( 1 );
+#endif
+    forEachCandidate( nSubnettingScans_, [&]( unsigned long i ) {
+#ifdef _OPENMP
+        SubnettingWorkspace &ws = workspaces[parallel ? omp_get_thread_num() : 0];
+#else
+        SubnettingWorkspace &ws = workspaces[0];
+#endif
+        SubnettingCandidate &candidate = subnettingCandidates_[i];
+        const Scan &parent1 = subnettingParents_[candidate.parent1];
+        const Scan &parent2 = subnettingParents_[candidate.parent2];
+        if ( !ws.scan1.is_initialized() ) {
+            ws.scan1 = parent1;
+            ws.scan2 = parent2;
+        }
+        subnettingStationIds( candidate, ws.ids1, ws.ids2 );
+        parent1.copySubset( ws.ids1, *ws.scan1 );
+        parent2.copySubset( ws.ids2, *ws.scan2 );
 
-    for ( auto &thisScans : subnettingScans_ ) {
-        Scan &thisScan1 = thisScans.first;
+        Scan &thisScan1 = *ws.scan1;
         unsigned long srcid1 = thisScan1.getSourceId();
         const auto &thisSource1 = sourceList.getSource( srcid1 );
         const unordered_map<unsigned long, double> &staids2skyCoverageScore1 = staids2skyCoverageScores[srcid1];
         thisScan1.calcScore_subnetting( astas_, asrcs_, abls_, minRequiredTime_, maxRequiredTime_, network, thisSource1,
                                         staids2skyCoverageScore1, idle_ );
-        //        double score1 = thisScan1.getScore();
+        candidate.score1 = thisScan1.getScore();
 
-        Scan &thisScan2 = thisScans.second;
+        Scan &thisScan2 = *ws.scan2;
         unsigned long srcid2 = thisScan2.getSourceId();
         const auto &thisSource2 = sourceList.getSource( srcid2 );
         const unordered_map<unsigned long, double> &staids2skyCoverageScore2 = staids2skyCoverageScores[srcid2];
         thisScan2.calcScore_subnetting( astas_, asrcs_, abls_, minRequiredTime_, maxRequiredTime_, network, thisSource2,
                                         staids2skyCoverageScore2, idle_ );
-        //        double score2 = thisScan2.getScore();
-    }
+        candidate.score2 = thisScan2.getScore();
+    } );
 }
 
 
@@ -497,7 +577,8 @@ void Subcon::generateScore( const Network &network, const SourceList &sourceList
         thisScan.calcScore( minRequiredTime_, maxRequiredTime_, network, thisSource, hiscore, false );
     }
 
-    for ( auto &thisScans : subnettingScans_ ) {
+    for ( unsigned long i = 0; i < nSubnettingScans_; ++i ) {
+        auto &thisScans = subnettingScans( i, sourceList );
         Scan &thisScan1 = thisScans.first;
         unsigned long srcid1 = thisScan1.getSourceId();
         const auto &thisSource1 = sourceList.getSource( srcid1 );
@@ -515,6 +596,8 @@ void Subcon::generateScore( const Network &network, const SourceList &sourceList
         double hiscore2 = thisMap2.at( thisSource2->getId() );
         thisScan2.calcScore( minRequiredTime_, maxRequiredTime_, network, thisSource2, hiscore2, true );
         //        double score2 = thisScan2.getScore();
+        subnettingCandidates_[i].score1 = thisScan1.getScore();
+        subnettingCandidates_[i].score2 = thisScan2.getScore();
     }
 }
 
@@ -545,24 +628,26 @@ void Subcon::generateScore( const std::vector<double> &lowElevatrionScore,
     }
 
     i = 0;
-    while ( i < subnettingScans_.size() ) {
-        Scan &thisScan1 = subnettingScans_[i].first;
+    while ( i < nSubnettingScans_ ) {
+        Scan &thisScan1 = subnettingScans( i, sourceList ).first;
 
         bool valid1 = thisScan1.calcScore( lowElevatrionScore, highElevationScore, network, minRequiredTime_,
                                            maxRequiredTime_, sourceList.getSource( thisScan1.getSourceId() ), true );
         //        double score1 = thisScan1.getScore();
 
-        Scan &thisScan2 = subnettingScans_[i].second;
+        Scan &thisScan2 = subnettingScans( i, sourceList ).second;
 
         bool valid2 = thisScan2.calcScore( lowElevatrionScore, highElevationScore, network, minRequiredTime_,
                                            maxRequiredTime_, sourceList.getSource( thisScan2.getSourceId() ), true );
         //        double score2 = thisScan2.getScore();
 
         if ( valid1 && valid2 ) {
+            subnettingCandidates_[i].score1 = thisScan1.getScore();
+            subnettingCandidates_[i].score2 = thisScan2.getScore();
             ++i;
         } else {
             --nSubnettingScans_;
-            subnettingScans_.erase( next( subnettingScans_.begin(), i ) );
+            subnettingCandidates_.erase( next( subnettingCandidates_.begin(), i ) );
         }
     }
 }
@@ -603,7 +688,8 @@ void Subcon::generateCalibratorScore( const Network &network, const SourceList &
         }
     }
 
-    for ( auto &tmp : subnettingScans_ ) {
+    for ( unsigned long i = 0; i < nSubnettingScans_; ++i ) {
+        auto &tmp = subnettingScans( i, sourceList );
         Scan &thisScan1 = tmp.first;
         Scan &thisScan2 = tmp.second;
         const auto &source1 = sourceList.getSource( thisScan1.getSourceId() );
@@ -638,6 +724,8 @@ void Subcon::generateCalibratorScore( const Network &network, const SourceList &
         } else {
             terminate();
         }
+        subnettingCandidates_[i].score1 = thisScan1.getScore();
+        subnettingCandidates_[i].score2 = thisScan2.getScore();
     }
 }
 
@@ -655,21 +743,27 @@ void Subcon::minMaxTime() noexcept {
             maxTime = thisTime;
         }
     }
-    for ( auto &thisScan : subnettingScans_ ) {
-        unsigned int thisTime1 = thisScan.first.getTimes().getScanDuration();
+    SubnettingWorkspace ws;
+    for ( const auto &candidate : subnettingCandidates_ ) {
+        unsigned int thisTime1;
+        if ( candidate.scans >= 0 ) {
+            thisTime1 = subnettingScans_[candidate.scans].first.getTimes().getScanDuration();
+        } else {
+            // evaluate duration without creating the subnetting scan
+            const Scan &parent1 = subnettingParents_[candidate.parent1];
+            if ( !ws.scan1.is_initialized() ) {
+                ws.scan1 = parent1;
+            }
+            subnettingStationIds( candidate, ws.ids1, ws.ids2 );
+            parent1.copySubset( ws.ids1, *ws.scan1 );
+            thisTime1 = ws.scan1->getTimes().getScanDuration();
+        }
         if ( thisTime1 < minTime ) {
             minTime = thisTime1;
         }
         if ( thisTime1 > maxTime ) {
             maxTime = thisTime1;
         }
-        unsigned int thisTime2 = thisScan.first.getTimes().getScanDuration();
-        if ( thisTime2 < minTime ) {
-            minTime = thisTime2;
-        }
-        if ( thisTime2 > maxTime ) {
-            maxTime = thisTime2;
-        }
     }
     minRequiredTime_ = minTime;
     maxRequiredTime_ = maxTime;
@@ -811,12 +905,13 @@ vector<Scan> Subcon::selectBest( Network &network, const SourceList &sourceList,
             scores.push_back( any.getScore() );
         }
     }
-    for ( const auto &any : subnettingScans_ ) {
-        if ( observedSources.find( any.first.getSourceId() ) != observedSources.end() ||
-             observedSources.find( any.first.getSourceId() ) != observedSources.end() ) {
-            scores.push_back( any.first.getScore() + any.second.getScore() * 0.01 );
+    for ( const auto &any : subnettingCandidates_ ) {
+        unsigned long srcid1 = subnettingParents_[any.parent1].getSourceId();
+        if ( observedSources.find( srcid1 ) != observedSources.end() ||
+             observedSources.find( srcid1 ) != observedSources.end() ) {
+            scores.push_back( any.score1 + any.score2 * 0.01 );
         } else {
-            scores.push_back( any.first.getScore() + any.second.getScore() );
+            scores.push_back( any.score1 + any.score2 );
         }
     }
 
@@ -828,8 +923,23 @@ vector<Scan> Subcon::selectBest( Network &network, const SourceList &sourceList,
     vector<unsigned long> scansToRemove;
 
     // loop through queue
-    unsigned long idx;
+    unsigned long idx = 0;
+
+    // rigorously updated scans which were not yet selected from queue
+    map<unsigned long, pair<bool, Scan>> speculative;
+
+    // pruned scans have to be restored as soon as one of them might have the highest score
+    prunedScansRestored_ = false;
+    auto checkPrunedScans = [&]() {
+        if ( !prunedCandidates_.empty() && ( q.empty() || q.top().first <= prunedMaxScore_ ) ) {
+            restorePrunedScans( network, sourceList, mode, endposition, observedSources, q, scansToRemove, idx );
+            // indices changed
+            speculative.clear();
+        }
+    };
+
     while ( true ) {
+        checkPrunedScans();
         if ( q.empty() ) {
             return bestScans;
         }
@@ -852,7 +962,12 @@ vector<Scan> Subcon::selectBest( Network &network, const SourceList &sourceList,
 
             const auto &thisSource = sourceList.getSource( thisScan.getSourceId() );
             // make rigorous update
-            bool flag = thisScan.rigorousUpdate( network, thisSource, mode, endposition );
+            bool flag;
+            if ( speculativeUpdates > 1 ) {
+                flag = speculativeRigorousUpdate( network, sourceList, mode, endposition, q, idx, speculative );
+            } else {
+                flag = thisScan.rigorousUpdate( network, thisSource, mode, endposition );
+            }
             if ( !flag ) {
                 scansToRemove.push_back( idx );
 #ifdef VIESCHEDPP_LOG
@@ -905,7 +1020,7 @@ vector<Scan> Subcon::selectBest( Network &network, const SourceList &sourceList,
 
         } else {
             unsigned long thisIdx = idx - nSingleScans_;
-            auto &thisScans = subnettingScans_[thisIdx];
+            auto &thisScans = subnettingScans( thisIdx, sourceList );
 
             // get scans with highest score
             Scan &thisScan1 = thisScans.first;
@@ -1013,6 +1128,7 @@ vector<Scan> Subcon::selectBest( Network &network, const SourceList &sourceList,
 
         // check if newly added score is again the highest score in the queue. If yes this is/are our selected
         // scan/scans
+        checkPrunedScans();
         unsigned long newIdx = q.top().second;
         if ( newIdx == idx ) {
             break;
@@ -1029,9 +1145,9 @@ vector<Scan> Subcon::selectBest( Network &network, const SourceList &sourceList,
         bestScans.push_back( std::move( bestScan ) );
     } else {
         unsigned long thisIdx = idx - nSingleScans_;
-        pair<Scan, Scan> bestScan_pair = takeSubnettingScans( thisIdx );
-        Scan bestScan1 = bestScan_pair.first;
-        Scan bestScan2 = bestScan_pair.second;
+        pair<Scan, Scan> bestScan_pair = takeSubnettingScans( thisIdx, sourceList );
+        Scan bestScan1 = std::move( bestScan_pair.first );
+        Scan bestScan2 = std::move( bestScan_pair.second );
 #ifdef VIESCHEDPP_LOG
         if ( Flags::logDebug )
             BOOST_LOG_TRIVIAL( debug ) << "subcon " << this->printId() << " scan " << bestScan1.printId() << " and "
@@ -1042,25 +1158,80 @@ vector<Scan> Subcon::selectBest( Network &network, const SourceList &sourceList,
         bestScans.push_back( std::move( bestScan2 ) );
     }
 
-    sort( scansToRemove.begin(), scansToRemove.end(), []( const int a, const int b ) { return a > b; } );
-
     // remove all scans which are invalid
 #ifdef VIESCHEDPP_LOG
     if ( Flags::logDebug ) BOOST_LOG_TRIVIAL( debug ) << "subcon " << this->printId() << " remove invalid scan(s) ";
 #endif
-    for ( auto invalidIdx : scansToRemove ) {
-        // if invalid index is larger as idx decrement it (source(s) with idx are already removed!)
-        if ( invalidIdx > idx ) {
-            --invalidIdx;
+    if ( !scansToRemove.empty() ) {
+        vector<char> flags( nSingleScans_ + nSubnettingScans_, false );
+        for ( auto invalidIdx : scansToRemove ) {
+            // if invalid index is larger as idx decrement it (source(s) with idx are already removed!)
+            if ( invalidIdx > idx ) {
+                --invalidIdx;
+            }
+            flags[invalidIdx] = true;
         }
-
-        removeScan( invalidIdx );
+        removeScans( flags );
     }
 
     return bestScans;
 }
 
 
+bool Subcon::speculativeRigorousUpdate( Network &network, const SourceList &sourceList,
+                                        const std::shared_ptr<const Mode> &mode,
+                                        const boost::optional<StationEndposition> &endposition,
+                                        std::priority_queue<std::pair<double, unsigned long>> &q, unsigned long idx,
+                                        std::map<unsigned long, std::pair<bool, Scan>> &speculative ) noexcept {
+    auto it = speculative.find( idx );
+    if ( it == speculative.end() ) {
+        // this scan and the next best single source scans in queue
+        vector<unsigned long> idxs{ idx };
+        vector<pair<double, unsigned long>> popped;
+        while ( popped.size() + 1 < speculativeUpdates && !q.empty() ) {
+            popped.push_back( q.top() );
+            q.pop();
+            unsigned long thisIdx = popped.back().second;
+            if ( thisIdx < nSingleScans_ && speculative.find( thisIdx ) == speculative.end() ) {
+                idxs.push_back( thisIdx );
+            }
+        }
+        for ( const auto &any : popped ) {
+            q.push( any );
+        }
+
+#ifdef VIESCHEDPP_LOG
+        if ( Flags::logDebug )
+            BOOST_LOG_TRIVIAL( debug ) << "subcon " << this->printId() << " speculative rigorous update of "
+                                       << idxs.size() << " scans";
+#endif
+        // updates are done on copies, the scans in the subcon are only changed once they are selected from queue
+        vector<Scan> scans;
+        scans.reserve( idxs.size() );
+        for ( unsigned long thisIdx : idxs ) {
+            scans.push_back( singleScans_[thisIdx] );
+        }
+        vector<char> valid( idxs.size() );
+        forEachCandidate( idxs.size(), [&]( unsigned long i ) {
+            const auto &thisSource = sourceList.getSource( scans[i].getSourceId() );
+            // stations are shared between worker threads -> rigorous azimuth/elevation cache is only read
+            Station::rigorousCacheReadOnly = true;
+            valid[i] = scans[i].rigorousUpdate( network, thisSource, mode, endposition );
+            Station::rigorousCacheReadOnly = false;
+        } );
+        for ( unsigned long i = 0; i < idxs.size(); ++i ) {
+            speculative.emplace( idxs[i], make_pair( valid[i] != 0, std::move( scans[i] ) ) );
+        }
+        it = speculative.find( idx );
+    }
+
+    bool flag = it->second.first;
+    singleScans_[idx] = std::move( it->second.second );
+    speculative.erase( it );
+    return flag;
+}
+
+
 void Subcon::removeScan( unsigned long idx ) noexcept {
     if ( idx < nSingleScans_ ) {
         unsigned long thisIdx = idx;
@@ -1076,27 +1247,124 @@ void Subcon::removeScan( unsigned long idx ) noexcept {
         unsigned long thisIdx = idx - nSingleScans_;
 #ifdef VIESCHEDPP_LOG
         if ( Flags::logDebug )
-            BOOST_LOG_TRIVIAL( debug ) << "subcon " << this->printId() << " remove scans "
-                                       << subnettingScans_[thisIdx].first.printId() << " and "
-                                       << subnettingScans_[thisIdx].second.printId();
+            BOOST_LOG_TRIVIAL( debug ) << "subcon " << this->printId() << " remove subnetting scans of "
+                                       << subnettingParents_[subnettingCandidates_[thisIdx].parent1].printId()
+                                       << " and "
+                                       << subnettingParents_[subnettingCandidates_[thisIdx].parent2].printId();
 #endif
 
-        subnettingScans_.erase( next( subnettingScans_.begin(), static_cast<int>( thisIdx ) ) );
+        subnettingCandidates_.erase( next( subnettingCandidates_.begin(), static_cast<int>( thisIdx ) ) );
         --nSubnettingScans_;
     }
 }
 
 
+void Subcon::removeScans( const std::vector<char> &flags ) noexcept {
+    unsigned long nValid = 0;
+    for ( unsigned long i = 0; i < nSingleScans_; ++i ) {
+        if ( flags[i] ) {
+#ifdef VIESCHEDPP_LOG
+            if ( Flags::logDebug )
+                BOOST_LOG_TRIVIAL( debug ) << "subcon " << this->printId() << " remove scan "
+                                           << singleScans_[i].printId();
+#endif
+            if ( pool_.get() != nullptr ) {
+                singleScans_[i].releaseBuffers( *pool_.get() );
+            }
+            continue;
+        }
+        if ( nValid != i ) {
+            singleScans_[nValid] = std::move( singleScans_[i] );
+        }
+        ++nValid;
+    }
+
+    unsigned long nValidSubnetting = 0;
+    for ( unsigned long i = 0; i < nSubnettingScans_; ++i ) {
+        if ( flags[nSingleScans_ + i] ) {
+#ifdef VIESCHEDPP_LOG
+            if ( Flags::logDebug )
+                BOOST_LOG_TRIVIAL( debug ) << "subcon " << this->printId() << " remove subnetting scans of "
+                                           << subnettingParents_[subnettingCandidates_[i].parent1].printId()
+                                           << " and "
+                                           << subnettingParents_[subnettingCandidates_[i].parent2].printId();
+#endif
+            continue;
+        }
+        if ( nValidSubnetting != i ) {
+            subnettingCandidates_[nValidSubnetting] = subnettingCandidates_[i];
+        }
+        ++nValidSubnetting;
+    }
+
+    singleScans_.erase( next( singleScans_.begin(), nValid ), singleScans_.end() );
+    nSingleScans_ = nValid;
+    subnettingCandidates_.erase( next( subnettingCandidates_.begin(), nValidSubnetting ),
+                                 subnettingCandidates_.end() );
+    nSubnettingScans_ = nValidSubnetting;
+}
+
+
 void Subcon::clearSubnettingScans() {
     nSubnettingScans_ = 0;
+    subnettingCandidates_.clear();
+    subnettingParents_.clear();
+    subnettingMasks_.clear();
     subnettingScans_.clear();
 }
 
+
+void Subcon::subnettingStationIds( const SubnettingCandidate &candidate, std::vector<unsigned long> &ids1,
+                                   std::vector<unsigned long> &ids2 ) const noexcept {
+    const uint64_t *mask = &subnettingMasks_[candidate.maskOffset];
+    auto inFirst = [mask]( unsigned long staid ) { return ( ( mask[staid / 64] >> ( staid % 64 ) ) & 1u ) != 0; };
+
+    ids1.clear();
+    const Scan &parent1 = subnettingParents_[candidate.parent1];
+    for ( int idx = 0; idx < parent1.getNSta(); ++idx ) {
+        unsigned long staid = parent1.getStationId( idx );
+        if ( inFirst( staid ) ) {
+            ids1.push_back( staid );
+        }
+    }
+
+    ids2.clear();
+    const Scan &parent2 = subnettingParents_[candidate.parent2];
+    for ( int idx = 0; idx < parent2.getNSta(); ++idx ) {
+        unsigned long staid = parent2.getStationId( idx );
+        if ( staid / 64 >= nMaskWords_ || !inFirst( staid ) ) {
+            ids2.push_back( staid );
+        }
+    }
+}
+
+
+std::pair<Scan, Scan> &Subcon::subnettingScans( unsigned long idx, const SourceList &sourceList ) noexcept {
+    SubnettingCandidate &candidate = subnettingCandidates_[idx];
+    if ( candidate.scans < 0 ) {
+        vector<unsigned long> ids1;
+        vector<unsigned long> ids2;
+        subnettingStationIds( candidate, ids1, ids2 );
+        const Scan &parent1 = subnettingParents_[candidate.parent1];
+        const Scan &parent2 = subnettingParents_[candidate.parent2];
+
+        // subsets were already checked during creation of the subnetting candidates
+        boost::optional<Scan> new_first = parent1.copyScan( ids1, sourceList.getSource( parent1.getSourceId() ) );
+        boost::optional<Scan> new_second = parent2.copyScan( ids2, sourceList.getSource( parent2.getSourceId() ) );
+#ifdef VIESCHEDPP_LOG
+        if ( Flags::logDebug )
+            BOOST_LOG_TRIVIAL( debug ) << "subcon " << this->printId() << " create subnetting scans "
+                                       << new_first->printId() << " and " << new_second->printId();
+#endif
+        candidate.scans = static_cast<long>( subnettingScans_.size() );
+        subnettingScans_.emplace_back( std::move( *new_first ), std::move( *new_second ) );
+    }
+    return subnettingScans_[candidate.scans];
+}
+
 void Subcon::checkTotalObservingTime( const Network &network, const SourceList &sourceList ) {
-    int iscan = 0;
-    while ( iscan < nSingleScans_ ) {
+    evaluateSingleScans( [&]( Scan &thisScan ) {
         bool scanValid = true;
-        auto &thisScan = singleScans_[iscan];
         const ScanTimes &times = thisScan.getTimes();
         const auto &thisSource = sourceList.getSource( thisScan.getSourceId() );
 
@@ -1114,20 +1382,8 @@ void Subcon::checkTotalObservingTime( const Network &network, const SourceList &
                 ++idx;
             }
         }
-
-        // if scan is valid increment scan counter, otherwise remove scan.
-        if ( scanValid ) {
-            ++iscan;
-        } else {
-#ifdef VIESCHEDPP_LOG
-            if ( Flags::logDebug )
-                BOOST_LOG_TRIVIAL( debug )
-                    << "subcon " << this->printId() << " scan " << thisScan.printId() << " no longer valid -> removed";
-#endif
-            singleScans_.erase( next( singleScans_.begin(), iscan ) );
-            --nSingleScans_;
-        }
-    }
+        return scanValid;
+    } );
 }
 
 
@@ -1144,12 +1400,10 @@ void Subcon::checkIfEnoughTimeToReachEndposition( const Network &network, const
 #endif
 
     // loop through all scans
-    int iscan = 0;
-    while ( iscan < nSingleScans_ ) {
+    evaluateSingleScans( [&]( Scan &thisScan ) {
         bool scanValid = true;
 
-        // current scan and source
-        auto &thisScan = singleScans_[iscan];
+        // current scan times and source
         const ScanTimes &times = thisScan.getTimes();
         const auto &thisSource = sourceList.getSource( thisScan.getSourceId() );
 
@@ -1199,34 +1453,250 @@ void Subcon::checkIfEnoughTimeToReachEndposition( const Network &network, const
             }
             ++istation;
         }
+        return scanValid;
+    } );
+}
+
+
+void Subcon::finishSingleScans( const Network &network, const SourceList &sourceList,
+                                const std::shared_ptr<const Mode> &mode,
+                                const boost::optional<StationEndposition> &endposition,
+                                DurationCache *cache ) noexcept {
+    constructAllBaselines( network, sourceList );
+    calcAllBaselineDurations( network, sourceList, mode, cache );
+    calcAllScanDurations( network, sourceList, endposition );
+    checkTotalObservingTime( network, sourceList );
+    checkIfEnoughTimeToReachEndposition( network, sourceList, endposition );
+}
 
-        // if scan is valid increment scan counter, otherwise remove scan.
-        if ( scanValid ) {
-            ++iscan;
+
+unsigned long Subcon::pruneSingleScans( const Network &network, const SourceList &sourceList,
+                                        double threshold ) noexcept {
+    // same idle time score as in prepareIdleTimeScore
+    vector<double> idle;
+    if ( WeightFactors::weightIdleTime != 0 ) {
+        unsigned int maxTime = 0;
+        for ( const auto &thisStation : network.getStations() ) {
+            maxTime = max( maxTime, thisStation.getCurrentTime() );
+        }
+        for ( const auto &thisStation : network.getStations() ) {
+            idle.push_back( static_cast<double>( maxTime - thisStation.getCurrentTime() ) /
+                            WeightFactors::idleTimeInterval );
+        }
+    }
+
+    unsigned long n = candidates_.size();
+    forEachCandidate( n, [&]( unsigned long c ) {
+        vector<unsigned long> staids;
+        candidates_.stationIds( c, staids );
+        const auto &thisSource = sourceList.getSource( candidates_.getSrcid( c ) );
+        candidates_.setScoreBound(
+            c, Scan::calcScoreUpperBound( staids, candidates_.getType( c ), network, thisSource, idle ) );
+    } );
+
+    // order preserving split into remaining and pruned candidates
+    vector<char> keep( n, true );
+    unsigned long nPruned = 0;
+    for ( unsigned long c = 0; c < n; ++c ) {
+        double bound = candidates_.getScoreBound( c );
+        if ( bound < threshold ) {
+            prunedMaxScore_ = max( prunedMaxScore_, bound );
+            keep[c] = false;
+            ++nPruned;
+        }
+    }
+    candidates_.split( keep, prunedCandidates_ );
+
+#ifdef VIESCHEDPP_LOG
+    if ( Flags::logDebug )
+        BOOST_LOG_TRIVIAL( debug ) << "subcon " << this->printId() << " pruned " << nPruned << " of " << n
+                                   << " scans (score upper bound below " << threshold << ")";
+#endif
+    return nPruned;
+}
+
+
+void Subcon::restorePrunedScans( const Network &network, const SourceList &sourceList,
+                                 const std::shared_ptr<const Mode> &mode,
+                                 const boost::optional<StationEndposition> &endposition,
+                                 const std::set<unsigned long> &observedSources,
+                                 std::priority_queue<std::pair<double, unsigned long>> &q,
+                                 std::vector<unsigned long> &scansToRemove, unsigned long &idx ) noexcept {
+#ifdef VIESCHEDPP_LOG
+    if ( Flags::logDebug )
+        BOOST_LOG_TRIVIAL( debug ) << "subcon " << this->printId() << " restore " << prunedCandidates_.size()
+                                   << " pruned scans";
+#endif
+    // create, finish and score pruned scans exactly like all other scans
+    vector<Scan> kept = std::move( singleScans_ );
+    unsigned long nKept = nSingleScans_;
+    singleScans_.clear();
+    nSingleScans_ = 0;
+    materializeCandidates( prunedCandidates_ );
+    prunedMaxScore_ = -numeric_limits<double>::infinity();
+    prunedScansRestored_ = true;
+
+    updateAzEl( network, sourceList );
+    finishSingleScans( network, sourceList, mode, endposition );
+    forEachCandidate( nSingleScans_, [&]( unsigned long i ) {
+        Scan &thisScan = singleScans_[i];
+        unordered_map<unsigned long, double> staids2skyCoverageScore;
+        const auto &thisSource = sourceList.getSource( thisScan.getSourceId() );
+        thisScan.calcScore( astas_, asrcs_, abls_, minRequiredTime_, maxRequiredTime_, network, thisSource,
+                            staids2skyCoverageScore, idle_ );
+    } );
+    vector<Scan> restored = std::move( singleScans_ );
+
+    // merge both lists, candidates are created in increasing source id order
+    singleScans_.clear();
+    singleScans_.reserve( kept.size() + restored.size() );
+    vector<unsigned long> newIdx( nKept );
+    vector<pair<double, unsigned long>> entries;
+    unsigned long i = 0;
+    unsigned long j = 0;
+    while ( i < kept.size() || j < restored.size() ) {
+        if ( j == restored.size() || ( i < kept.size() && kept[i].getSourceId() < restored[j].getSourceId() ) ) {
+            newIdx[i] = singleScans_.size();
+            singleScans_.push_back( std::move( kept[i] ) );
+            ++i;
+        } else {
+            double score = restored[j].getScore();
+            if ( observedSources.find( restored[j].getSourceId() ) != observedSources.end() ) {
+                score *= 0.01;
+            }
+            entries.emplace_back( score, singleScans_.size() );
+            singleScans_.push_back( std::move( restored[j] ) );
+            ++j;
+        }
+    }
+    nSingleScans_ = singleScans_.size();
+
+    // renumber queue and all stored indices
+    auto renumber = [&]( unsigned long oldIdx ) {
+        return oldIdx < nKept ? newIdx[oldIdx] : oldIdx - nKept + nSingleScans_;
+    };
+    while ( !q.empty() ) {
+        entries.emplace_back( q.top().first, renumber( q.top().second ) );
+        q.pop();
+    }
+    q = std::priority_queue<std::pair<double, unsigned long>>( entries.begin(), entries.end() );
+    for ( auto &any : scansToRemove ) {
+        any = renumber( any );
+    }
+    idx = renumber( idx );
+}
+
+
+void Subcon::evaluateSingleScans( const std::function<bool( Scan & )> &evaluate ) noexcept {
+    materializeCandidates( candidates_ );
+
+    vector<char> valid( nSingleScans_, true );
+    forEachCandidate( nSingleScans_, [&]( unsigned long i ) { valid[i] = evaluate( singleScans_[i] ); } );
+
+    // remove invalid scans, order of remaining scans is preserved
+    unsigned long nValid = 0;
+    for ( unsigned long i = 0; i < nSingleScans_; ++i ) {
+        if ( valid[i] ) {
+            if ( nValid != i ) {
+                singleScans_[nValid] = std::move( singleScans_[i] );
+            }
+            ++nValid;
         } else {
 #ifdef VIESCHEDPP_LOG
             if ( Flags::logDebug )
-                BOOST_LOG_TRIVIAL( debug )
-                    << "subcon " << this->printId() << " scan " << thisScan.printId() << " no longer valid -> removed";
+                BOOST_LOG_TRIVIAL( debug ) << "subcon " << this->printId() << " scan " << singleScans_[i].printId()
+                                           << " no longer valid -> removed";
+#endif
+            if ( pool_.get() != nullptr ) {
+                singleScans_[i].releaseBuffers( *pool_.get() );
+            }
+        }
+    }
+    singleScans_.erase( next( singleScans_.begin(), nValid ), singleScans_.end() );
+    nSingleScans_ = nValid;
+}
+
+
+bool Subcon::candidatesInParallel( unsigned long n ) noexcept {
+#ifdef _OPENMP
+    return parallelEvaluation && n > 1 && !omp_in_parallel();
+#else
+    return false;
 #endif
+}
 
-            singleScans_.erase( next( singleScans_.begin(), iscan ) );
-            --nSingleScans_;
+
+void Subcon::forEachCandidate( unsigned long n, const std::function<void( unsigned long )> &f ) noexcept {
+#ifdef _OPENMP
+    if ( candidatesInParallel( n ) ) {
+        // weight factors and scan sequence are thread local -> pass values of calling thread to all worker threads
+        const WeightFactors::Values weights = WeightFactors::get();
+        const unsigned int scanSequence_modulo = Scan::scanSequence_modulo;
+        const auto nn = static_cast<long>( n );
+#pragma omp parallel
+        {
+            WeightFactors::set( weights );
+            Scan::scanSequence_modulo = scanSequence_modulo;
+#pragma omp for schedule( dynamic )
+            for ( long i = 0; i < nn; ++i ) {
+                f( static_cast<unsigned long>( i ) );
+            }
         }
+        return;
+    }
+#endif
+    for ( unsigned long i = 0; i < n; ++i ) {
+        f( i );
     }
 }
 
 
 void Subcon::changeType( Scan::ScanType type ) {
+    materializeCandidates( candidates_ );
     for ( auto &any : singleScans_ ) {
         any.setType( type );
     }
 }
 
 
+void Subcon::materializeCandidates( CandidateTable &table ) noexcept {
+    if ( table.empty() ) {
+        return;
+    }
+
+    ScanPool *pool = pool_.get();
+    singleScans_.reserve( singleScans_.size() + table.size() );
+    vector<unsigned int> endOfLastScans;
+    for ( unsigned long c = 0; c < table.size(); ++c ) {
+        vector<PointingVector> pointingVectors = pool != nullptr ? pool->takePointingVectors() : vector<PointingVector>();
+        endOfLastScans.clear();
+        for ( unsigned long r = table.firstRow( c ); r < table.endRow( c ); ++r ) {
+            if ( table.isActive( c, r ) ) {
+                pointingVectors.push_back( table.pointingVector( c, r ) );
+                endOfLastScans.push_back( table.getEndOfLastScan( r ) );
+            }
+        }
+
+        Scan scan( pointingVectors, endOfLastScans, table.getType( c ), pool );
+        if ( table.hasStartTimes() ) {
+            int idx = 0;
+            for ( unsigned long r = table.firstRow( c ); r < table.endRow( c ); ++r ) {
+                if ( table.isActive( c, r ) ) {
+                    scan.addTimes( idx, table.getFieldSystem( r ), table.getSlew( r ), table.getPreob( r ) );
+                    ++idx;
+                }
+            }
+            scan.referenceTime().alignStartTimes();
+        }
+        addScan( std::move( scan ) );
+    }
+    table.reset( table.getNetworkSize() );
+}
+
+
 void Subcon::visibleScan( unsigned int currentTime, Scan::ScanType type, const Network &network,
-                          shared_ptr<const AbstractSource> thisSource, std::set<unsigned long> observedSources,
-                          bool doNotObserveSourcesWithinMinRepeat ) {
+                          shared_ptr<const AbstractSource> thisSource, const std::set<unsigned long> &observedSources,
+                          bool doNotObserveSourcesWithinMinRepeat, CandidateCache *cache ) {
     unsigned long srcid = thisSource->getId();
 
     if ( !thisSource->getPARA().available || !thisSource->getPARA().globalAvailable ) {
@@ -1303,10 +1773,12 @@ void Subcon::visibleScan( unsigned int currentTime, Scan::ScanType type, const N
                                    << thisSource->getName();
 #endif
 
+    if ( candidates_.getNetworkSize() != network.getNSta() ) {
+        candidates_.reset( network.getNSta() );
+    }
+
     unsigned int availableSta = 0;
     unsigned int visibleSta = 0;
-    vector<PointingVector> pointingVectors;
-    vector<unsigned int> endOfLastScans;
     for ( const auto &thisSta : network.getStations() ) {
         unsigned long staid = thisSta.getId();
 
@@ -1382,13 +1854,21 @@ void Subcon::visibleScan( unsigned int currentTime, Scan::ScanType type, const N
 
         p.setTime( time );
 
-        thisSta.calcAzEl_simple( thisSource, p );
+        if ( cache != nullptr ) {
+            cache->calcAzEl( thisSta, thisSource, p );
+        } else {
+            thisSta.calcAzEl_simple( thisSource, p );
+        }
 
-        bool flag = thisSta.isVisible( p, thisSource->getPARA().minElevation );
+        bool flag;
+        if ( cache != nullptr ) {
+            flag = cache->isVisible( thisSta, p, thisSource->getPARA().minElevation );
+        } else {
+            flag = thisSta.isVisible( p, thisSource->getPARA().minElevation );
+        }
         if ( flag ) {
             visibleSta++;
-            endOfLastScans.push_back( thisSta.getCurrentTime() );
-            pointingVectors.push_back( std::move( p ) );
+            candidates_.addRow( thisSta.getCurrentTime(), p );
 #ifdef VIESCHEDPP_LOG
             if ( Flags::logTrace )
                 BOOST_LOG_TRIVIAL( trace ) << "subcon " << this->printId() << " source " << thisSource->getName()
@@ -1405,14 +1885,8 @@ void Subcon::visibleScan( unsigned int currentTime, Scan::ScanType type, const N
 
     if ( !thisSource->getPARA().requiredStations.empty() ) {
         for ( unsigned long requiredStationId : thisSource->getPARA().requiredStations ) {
-            bool found = false;
-            for ( const auto &pv : pointingVectors ) {
-                if ( pv.getStaid() == requiredStationId ) {
-                    found = true;
-                    break;
-                }
-            }
-            if ( !found ) {
+            if ( !candidates_.hasPendingStation( requiredStationId ) ) {
+                candidates_.discardPending();
                 return;
             }
         }
@@ -1420,7 +1894,9 @@ void Subcon::visibleScan( unsigned int currentTime, Scan::ScanType type, const N
 
     if ( visibleSta >= thisSource->getPARA().minNumberOfStations ||
          ( visibleSta == availableSta && availableSta >= 2 ) ) {
-        addScan( Scan( pointingVectors, endOfLastScans, type ) );
+        candidates_.addCandidate( srcid, type );
+    } else {
+        candidates_.discardPending();
     }
 }
 void Subcon::checkCalibratorScores( Scan &scan1, Scan &scan2 ) {
@@ -29,18 +29,24 @@
 
 
 #include <boost/optional.hpp>
+#include <cstdint>
+#include <functional>
 #include <limits>
 #include <numeric>
 #include <queue>
 #include <utility>
 #include <vector>
 
+#include "../Misc/ObjectCounter.h"
 #include "../Misc/StationEndposition.h"
 #include "../Misc/Subnetting.h"
 #include "../Source/AbstractSource.h"
 #include "../Source/SourceList.h"
 #include "../Station/Network.h"
+#include "CandidateCache.h"
+#include "CandidateTable.h"
 #include "Scan.h"
+#include "ScanPool.h"
 
 
 namespace VieVS {
@@ -53,6 +59,10 @@ namespace VieVS {
  */
 class Subcon : public VieVS_Object {
    public:
+    static bool parallelEvaluation;          ///< flag if scan candidates are evaluated in parallel (OpenMP)
+    static unsigned int speculativeUpdates;  ///< number of best scans rigorously updated in advance (in parallel)
+
+
     /**
      * @brief empty default constructor
      * @author Matthias Schartner
@@ -60,6 +70,34 @@ class Subcon : public VieVS_Object {
     Subcon();
 
 
+    Subcon( const Subcon &other ) = default;
+    Subcon( Subcon &&other ) = default;
+    Subcon &operator=( const Subcon &other ) = default;
+    Subcon &operator=( Subcon &&other ) = default;
+
+
+    /**
+     * @brief destructor
+     * @author Matthias Schartner
+     *
+     * gives the buffers of all remaining scans back to the scan pool (if set)
+     */
+    ~Subcon();
+
+
+    /**
+     * @brief set pool of released scan buffers
+     * @author Matthias Schartner
+     *
+     * Scans created from the candidates of visibleScan() reuse buffers of this pool. Discarded scans and all remaining scans give their
+     * buffers back to the pool once the subcon is destroyed. The pool must outlive the subcon. Copies of this subcon
+     * do not use the pool, moving transfers the pool.
+     *
+     * @param pool pool of released scan buffers
+     */
+    void setScanPool( ScanPool *pool ) noexcept { pool_ = pool; }
+
+
     /**
      * @brief add a single source scan to subcon
      * @author Matthias Schartner
@@ -81,13 +119,27 @@ class Subcon : public VieVS_Object {
     void removeScan( unsigned long idx ) noexcept;
 
 
+    /**
+     * @brief removes all flagged scans from the subcon
+     * @author Matthias Schartner
+     *
+     * Same index convention as removeScan(). All flagged scans are removed in one pass which preserves the order of
+     * all remaining scans.
+     *
+     * @param flags flag per scan index (true if scan should be removed)
+     */
+    void removeScans( const std::vector<char> &flags ) noexcept;
+
+
     /**
      * @brief getter for number of possible single source scans
      * @author Matthias Schartner
      *
+     * Includes candidates for which no scan is created yet.
+     *
      * @return number of possible single source scans
      */
-    unsigned long getNumberSingleScans() const noexcept { return nSingleScans_; }
+    unsigned long getNumberSingleScans() const noexcept { return nSingleScans_ + candidates_.size(); }
 
 
     /**
@@ -119,13 +171,14 @@ class Subcon : public VieVS_Object {
      * @author Matthias Schartner
      *
      * @param idx index
+     * @param sourceList list of all sources
      * @return subnetting scan at this index
      */
-    std::pair<Scan, Scan> takeSubnettingScans( unsigned long idx ) noexcept {
-        std::pair<Scan, Scan> tmp = std::move( subnettingScans_[idx] );
-        subnettingScans_.erase( subnettingScans_.begin() + idx );
+    std::pair<Scan, Scan> takeSubnettingScans( unsigned long idx, const SourceList &sourceList ) noexcept {
+        std::pair<Scan, Scan> tmp = std::move( subnettingScans( idx, sourceList ) );
+        subnettingCandidates_.erase( subnettingCandidates_.begin() + idx );
         --nSubnettingScans_;
-        return std::move( tmp );
+        return tmp;
     }
 
 
@@ -133,12 +186,17 @@ class Subcon : public VieVS_Object {
      * @brief calculates the earliest possible start time for all single source scans in this subcon
      * @author Matthias Schartner
      *
+     * Works on the candidates of visibleScan() before any scan is created, thus it has to be called before
+     * updateAzEl().
+     *
      * @param network station network
      * @param sourceList list of all sources
      * @param endposition required endposition
+     * @param cache partial results of previous scan selections (optional)
      */
     void calcStartTimes( const Network &network, const SourceList &sourceList,
-                         const boost::optional<StationEndposition> &endposition = boost::none ) noexcept;
+                         const boost::optional<StationEndposition> &endposition = boost::none,
+                         CandidateCache *cache = nullptr ) noexcept;
 
 
     /**
@@ -155,6 +213,8 @@ class Subcon : public VieVS_Object {
      * @brief updates all azimuths and elevations of all pointing vectors for each single source scan in this subcon
      * @author Matthias Schartner
      *
+     * Scans are created for all remaining candidates first.
+     *
      * @param network station network
      * @param sourceList list of all sources
      */
@@ -168,9 +228,10 @@ class Subcon : public VieVS_Object {
      * @param network station network
      * @param sourceList list of all sources
      * @param mode observing mode
+     * @param cache cache of required observing durations (optional)
      */
     void calcAllBaselineDurations( const Network &network, const SourceList &sourceList,
-                                   const std::shared_ptr<const Mode> &mode ) noexcept;
+                                   const std::shared_ptr<const Mode> &mode, DurationCache *cache = nullptr ) noexcept;
 
 
     /**
@@ -267,6 +328,60 @@ class Subcon : public VieVS_Object {
                                               const boost::optional<StationEndposition> &endposition = boost::none );
 
 
+    /**
+     * @brief construct baselines, calculate observing durations and check all constraints of all single source scans
+     * @author Matthias Schartner
+     *
+     * All steps required after updateAzEl()
+     *
+     * @param network station network
+     * @param sourceList list of all sources
+     * @param mode observing mode
+     * @param endposition required endposition
+     * @param cache cache of required observing durations (optional)
+     */
+    void finishSingleScans( const Network &network, const SourceList &sourceList,
+                            const std::shared_ptr<const Mode> &mode,
+                            const boost::optional<StationEndposition> &endposition = boost::none,
+                            DurationCache *cache = nullptr ) noexcept;
+
+
+    /**
+     * @brief put all single source scans aside which can not reach a minimum score
+     * @author Matthias Schartner
+     *
+     * Has to be called after calcStartTimes() and before updateAzEl(), pruned candidates are never turned into scans
+     * unless they are restored. Only valid for standard scans without
+     * subnetting and only if Scan::scoreUpperBoundValid() is true (see Scan::calcScoreUpperBound()).
+     * The pruned scans are restored automatically during selectBest() in case any of them might still win, therefore
+     * the selected scan is always identical to the one selected without pruning.
+     *
+     * @param network station network
+     * @param sourceList list of all sources
+     * @param threshold scans with a score upper bound below this value are pruned
+     * @return number of pruned scans
+     */
+    unsigned long pruneSingleScans( const Network &network, const SourceList &sourceList, double threshold ) noexcept;
+
+
+    /**
+     * @brief getter for number of pruned single source scans
+     * @author Matthias Schartner
+     *
+     * @return number of pruned single source scans
+     */
+    unsigned long getNumberPrunedScans() const noexcept { return prunedCandidates_.size(); }
+
+
+    /**
+     * @brief flag if pruned scans had to be restored during last selectBest() call
+     * @author Matthias Schartner
+     *
+     * @return true if pruned scans were restored
+     */
+    bool prunedScansRestored() const noexcept { return prunedScansRestored_; }
+
+
     /**
      * @brief get minimum and maximum time required for a possible scan
      * @author Matthias Schartner
@@ -344,17 +459,20 @@ class Subcon : public VieVS_Object {
      * @brief create possible visible scan to a source
      * @author Matthias Schartner
      *
+     * The scan is only stored as candidate, the scan object is created once it is required (see updateAzEl()).
+     *
      * @param currentTime current start time
      * @param type scan type
      * @param network station network
      * @param thisSource target source
      * @param observedSources list of priviously observed sources
      * @param doNotObserveSourcesWithinMinRepeat consider scans (with reduced weight) if they are within min repeat time
+     * @param cache partial results of previous scan selections (optional)
      */
     void visibleScan( unsigned int currentTime, Scan::ScanType type, const Network &network,
                       std::shared_ptr<const AbstractSource> thisSource,
-                      std::set<unsigned long> observedSources = std::set<unsigned long>(),
-                      bool doNotObserveSourcesWithinMinRepeat = true );
+                      const std::set<unsigned long> &observedSources = std::set<unsigned long>(),
+                      bool doNotObserveSourcesWithinMinRepeat = true, CandidateCache *cache = nullptr );
 
 
     /**
@@ -366,13 +484,68 @@ class Subcon : public VieVS_Object {
     const std::vector<Scan> &getSingleSourceScans() const { return singleScans_; }
 
    private:
-    static unsigned long nextId;  ///< next id for this object type
+    static IdCounter nextId;  ///< next id for this object type
 
     unsigned long nSingleScans_ = 0;  ///< number of single source scans
     std::vector<Scan> singleScans_;   ///< all single source scans
+    CandidateTable candidates_;       ///< single source scans for which no scan object is created yet
+
+    /**
+     * @brief non-owning reference to the scan pool
+     * @author Matthias Schartner
+     *
+     * Only one subcon gives its buffers back to the pool: copies do not reference the pool and moved-from subcons
+     * lose their reference.
+     */
+    class PoolRef {
+       public:
+        PoolRef() = default;
+        PoolRef( const PoolRef & ) noexcept {}
+        PoolRef( PoolRef &&other ) noexcept : pool_{ other.pool_ } { other.pool_ = nullptr; }
+        PoolRef &operator=( const PoolRef & ) noexcept {
+            pool_ = nullptr;
+            return *this;
+        }
+        PoolRef &operator=( PoolRef &&other ) noexcept {
+            pool_ = other.pool_;
+            other.pool_ = nullptr;
+            return *this;
+        }
+        PoolRef &operator=( ScanPool *pool ) noexcept {
+            pool_ = pool;
+            return *this;
+        }
 
-    unsigned long nSubnettingScans_ = 0;                  ///< number of subnetting scans
-    std::vector<std::pair<Scan, Scan>> subnettingScans_;  ///< all subnetting scans
+        ScanPool *get() const noexcept { return pool_; }
+
+       private:
+        ScanPool *pool_ = nullptr;  ///< pool of released scan buffers
+    };
+    PoolRef pool_;  ///< pool of released scan buffers (optional)
+
+    /**
+     * @brief lightweight description of a subnetting scan pair
+     * @author Matthias Schartner
+     *
+     * Both scans are subsets of the single source scans stored in subnettingParents_. The station mask (stored in
+     * subnettingMasks_ with nMaskWords_ words) contains all stations of the first scan, the second scan gets
+     * all remaining stations of its parent. The scans themselves are only created if they are required.
+     */
+    struct SubnettingCandidate {
+        unsigned long parent1;     ///< index of parent of first scan in subnettingParents_
+        unsigned long parent2;     ///< index of parent of second scan in subnettingParents_
+        unsigned long maskOffset;  ///< offset of station mask of first scan
+        double score1 = 0;         ///< score of first scan
+        double score2 = 0;         ///< score of second scan
+        long scans = -1;           ///< index of created scans in subnettingScans_ (-1 if not yet created)
+    };
+
+    unsigned long nSubnettingScans_ = 0;                     ///< number of subnetting scans
+    std::vector<SubnettingCandidate> subnettingCandidates_;  ///< all subnetting scans
+    std::vector<Scan> subnettingParents_;    ///< copies of all single source scans referenced by a subnetting scan
+    std::vector<uint64_t> subnettingMasks_;  ///< flattened station masks of first scans
+    unsigned long nMaskWords_ = 0;           ///< number of 64 bit words per station mask in subnettingMasks_
+    std::vector<std::pair<Scan, Scan>> subnettingScans_;  ///< already created subnetting scans
 
     unsigned int minRequiredTime_ = std::numeric_limits<unsigned int>::max();  ///< minimum time required for a scan
     unsigned int maxRequiredTime_ = std::numeric_limits<unsigned int>::min();  ///< maximum time required for a scan
@@ -382,6 +555,64 @@ class Subcon : public VieVS_Object {
     std::vector<double> abls_;   ///< average baseline score for each baseline
     std::vector<double> idle_;   ///< extra score for long idle time
 
+    CandidateTable prunedCandidates_;                                   ///< pruned single source scans
+    double prunedMaxScore_ = -std::numeric_limits<double>::infinity();  ///< maximum score upper bound of pruned scans
+    bool prunedScansRestored_ = false;  ///< flag if pruned scans were restored during scan selection
+
+    /**
+     * @brief station ids of both scans of a subnetting scan pair
+     * @author Matthias Schartner
+     *
+     * @param candidate subnetting scan description
+     * @param ids1 station ids of first scan
+     * @param ids2 station ids of second scan
+     */
+    void subnettingStationIds( const SubnettingCandidate &candidate, std::vector<unsigned long> &ids1,
+                               std::vector<unsigned long> &ids2 ) const noexcept;
+
+    /**
+     * @brief get subnetting scans (created if necessary)
+     * @author Matthias Schartner
+     *
+     * @param idx subnetting scan index
+     * @param sourceList list of all sources
+     * @return subnetting scan pair
+     */
+    std::pair<Scan, Scan> &subnettingScans( unsigned long idx, const SourceList &sourceList ) noexcept;
+
+    /**
+     * @brief finish all pruned scans and merge them back into list of single source scans
+     * @author Matthias Schartner
+     *
+     * Scans are created for all pruned candidates and inserted at the position they had before pruning (scans are
+     * sorted by source id). Queue entries and indices of invalid scans are renumbered accordingly.
+     *
+     * @param network station network
+     * @param sourceList list of all sources
+     * @param mode observing mode
+     * @param endposition required endposition
+     * @param observedSources sources which get reduced score
+     * @param q queue of scores and scan indices
+     * @param scansToRemove indices of invalid scans
+     * @param idx index of current scan
+     */
+    void restorePrunedScans( const Network &network, const SourceList &sourceList,
+                             const std::shared_ptr<const Mode> &mode,
+                             const boost::optional<StationEndposition> &endposition,
+                             const std::set<unsigned long> &observedSources,
+                             std::priority_queue<std::pair<double, unsigned long>> &q,
+                             std::vector<unsigned long> &scansToRemove, unsigned long &idx ) noexcept;
+
+    /**
+     * @brief create scans for all candidates of table and add them to single source scans
+     * @author Matthias Schartner
+     *
+     * The table is empty afterwards.
+     *
+     * @param table candidates
+     */
+    void materializeCandidates( CandidateTable &table ) noexcept;
+
     /**
      * @brief precalculate all necessary parameters to generate scores
      * @author Matthias Schartner
@@ -437,6 +668,65 @@ class Subcon : public VieVS_Object {
      */
     std::vector<double> prepareAverageScore_base( const std::vector<unsigned long> &nobs ) noexcept;
 
+    /**
+     * @brief evaluate all single source scans and remove invalid scans
+     * @author Matthias Schartner
+     *
+     * The evaluation of each scan is independent and is done in parallel if parallelEvaluation is set. Invalid scans
+     * are removed afterwards in a serial pass which preserves the order of all remaining scans.
+     *
+     * @param evaluate function which updates a single scan and returns false if scan is no longer valid
+     */
+    void evaluateSingleScans( const std::function<bool( Scan & )> &evaluate ) noexcept;
+
+
+    /**
+     * @brief call function for each index in [0, n)
+     * @author Matthias Schartner
+     *
+     * Runs in parallel if parallelEvaluation is set and the caller is not already inside a parallel region. The
+     * thread local weight factors and scan sequence state of the calling thread are passed to all worker threads.
+     *
+     * @param n number of elements
+     * @param f function called with element index
+     */
+    static void forEachCandidate( unsigned long n, const std::function<void( unsigned long )> &f ) noexcept;
+
+
+    /**
+     * @brief check if forEachCandidate() runs in parallel
+     * @author Matthias Schartner
+     *
+     * @param n number of elements
+     * @return true if forEachCandidate() uses its own parallel region
+     */
+    static bool candidatesInParallel( unsigned long n ) noexcept;
+
+
+    /**
+     * @brief rigorous update of single source scan using speculative updates
+     * @author Matthias Schartner
+     *
+     * If there is no speculative result for this scan, this scan and the next best single source scans in the queue
+     * (speculativeUpdates scans in total) are rigorously updated in parallel. The updates are independent of each
+     * other and are applied later in the same order as without speculation, therefore the result is identical.
+     *
+     * @param network station network
+     * @param sourceList list of all sources
+     * @param mode observing mode
+     * @param endposition required endposition
+     * @param q queue of scores and scan indices (unchanged)
+     * @param idx index of single source scan which should be updated
+     * @param speculative speculative results (validity flag and updated scan) for each scan index
+     * @return true if scan is still valid
+     */
+    bool speculativeRigorousUpdate( Network &network, const SourceList &sourceList,
+                                    const std::shared_ptr<const Mode> &mode,
+                                    const boost::optional<StationEndposition> &endposition,
+                                    std::priority_queue<std::pair<double, unsigned long>> &q, unsigned long idx,
+                                    std::map<unsigned long, std::pair<bool, Scan>> &speculative ) noexcept;
+
+
     static void checkCalibratorScores( Scan &scan1 );
 
     static void checkCalibratorScores( Scan &scan1, Scan &scan2 );
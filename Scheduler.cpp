@@ -74,6 +74,8 @@ Scheduler::Scheduler( Initializer &init, string path, string fname )
     parameters_.writeSkyCoverageData = false;
     parameters_.doNotObserveSourcesWithinMinRepeat = init.parameters_.doNotObserveSourcesWithinMinRepeat;
     parameters_.ignoreSuccessiveScansSameSrc = init.parameters_.ignoreSuccessiveScansSameSrc;
+    parameters_.candidatePruning = init.parameters_.candidatePruning;
+    parameters_.candidatePruningFactor = init.parameters_.candidatePruningFactor;
 }
 
 
@@ -173,6 +175,7 @@ void Scheduler::startScanSelection( unsigned int endTime, std::ofstream &of, Sca
 
         unsigned long nSingleScans = subcon.getNumberSingleScans();
         unsigned long nSubnettingScans = subcon.getNumberSubnettingScans();
+        unsigned long nPrunedScans = subcon.getNumberPrunedScans();
 
         // select the best possible next scan(s) and save them under 'bestScans'
         vector<Scan> bestScans;
@@ -184,6 +187,14 @@ void Scheduler::startScanSelection( unsigned int endTime, std::ofstream &of, Sca
             bestScans = subcon.selectBest( network_, sourceList_, currentObservingMode_, prevLowElevationScores,
                                            prevHighElevationScores, opt_endposition );
         }
+        if ( subcon.prunedScansRestored() ) {
+            nSingleScans += nPrunedScans;
+            nPrunedScans = 0;
+            ++nPrunedScansRestored;
+        }
+        if ( type == Scan::ScanType::standard && bestScans.size() == 1 ) {
+            lastBestScore_ = bestScans[0].getScore();
+        }
 
         if ( FocusCorners::startFocusCorner && depth == 0 && FocusCorners::iscan >= FocusCorners::nscans ) {
             FocusCorners::reset( bestScans, sourceList_ );
@@ -373,7 +384,7 @@ void Scheduler::startScanSelection( unsigned int endTime, std::ofstream &of, Sca
         }
 
         // update best possible scans
-        consideredUpdate( nSingleScans, nSubnettingScans, depth, of );
+        consideredUpdate( nSingleScans, nSubnettingScans, depth, of, nPrunedScans );
         for ( auto &bestScan : bestScans ) {
             update( bestScan, of );
         }
@@ -611,6 +622,43 @@ void Scheduler::statistics( ofstream &of ) {
     of << boost::format( "| %-35s %d (single source scans %d, subnetting scans %d) %143t|\n" ) %
               "total scans considered" % ( nSingleScansConsidered + 2 * nSubnettingScansConsidered ) %
               nSingleScansConsidered % ( 2 * nSubnettingScansConsidered );
+    unsigned long nCacheRequests = candidateCache_.getHits() + candidateCache_.getMisses();
+    if ( nCacheRequests > 0 ) {
+        of << boost::format( "| %-35s %d of %d (%.1f %%) %143t|\n" ) % "reused station/source results" %
+                  candidateCache_.getHits() % nCacheRequests %
+                  ( 100.0 * candidateCache_.getHits() / static_cast<double>( nCacheRequests ) );
+    }
+    unsigned long nDurationRequests = durationCache_.getHits() + durationCache_.getMisses();
+    if ( nDurationRequests > 0 ) {
+        of << boost::format( "| %-35s %d of %d (%.1f %%) %143t|\n" ) % "reused observing durations" %
+                  durationCache_.getHits() % nDurationRequests %
+                  ( 100.0 * durationCache_.getHits() / static_cast<double>( nDurationRequests ) );
+    }
+    unsigned long nRigorousHits = 0;
+    unsigned long nRigorousRequests = 0;
+    for ( const auto &sta : network_.getStations() ) {
+        nRigorousHits += sta.getRigorousCacheHits();
+        nRigorousRequests += sta.getRigorousCacheHits() + sta.getRigorousCacheMisses();
+    }
+    if ( nRigorousRequests > 0 ) {
+        of << boost::format( "| %-35s %d of %d (%.1f %%) %143t|\n" ) % "reused rigorous az/el results" %
+                  nRigorousHits % nRigorousRequests %
+                  ( 100.0 * nRigorousHits / static_cast<double>( nRigorousRequests ) );
+#ifdef VIESCHEDPP_LOG
+        BOOST_LOG_TRIVIAL( info ) << boost::format( "%s reused %d of %d rigorous az/el results (%.1f %%)" ) %
+                                         getName() % nRigorousHits % nRigorousRequests %
+                                         ( 100.0 * nRigorousHits / static_cast<double>( nRigorousRequests ) );
+#endif
+    }
+    if ( scanPool_.getRequested() > 0 ) {
+        of << boost::format( "| %-35s %d of %d (%.1f %%) %143t|\n" ) % "reused scan buffers" %
+                  scanPool_.getReused() % scanPool_.getRequested() %
+                  ( 100.0 * scanPool_.getReused() / static_cast<double>( scanPool_.getRequested() ) );
+    }
+    if ( nSingleScansPruned > 0 || nPrunedScansRestored > 0 ) {
+        of << boost::format( "| %-35s %d (restored during %d scan selections) %143t|\n" ) %
+                  "pruned single source scans" % nSingleScansPruned % nPrunedScansRestored;
+    }
 
 #ifdef VIESCHEDPP_LOG
     BOOST_LOG_TRIVIAL( info ) << "created schedule with " << scans_.size() << " scans and " << nobs << " observations";
@@ -623,13 +671,19 @@ void Scheduler::statistics( ofstream &of ) {
 Subcon Scheduler::createSubcon( const shared_ptr<Subnetting> &subnetting, Scan::ScanType type,
                                 const boost::optional<StationEndposition> &endposition ) noexcept {
     Subcon subcon = allVisibleScans( type, endposition, parameters_.doNotObserveSourcesWithinMinRepeat );
-    subcon.calcStartTimes( network_, sourceList_, endposition );
+    subcon.calcStartTimes( network_, sourceList_, endposition, &candidateCache_ );
+
+    // prune scans which can not reach the previous best score before any scan object is created. Pruned scans are
+    // restored during scan selection if necessary. Only possible if subcon is not reused and the score upper bound is
+    // valid.
+    if ( parameters_.candidatePruning && subnetting == nullptr && !parameters_.fillinmodeDuringScanSelection &&
+         !FocusCorners::startFocusCorner && Scan::scoreUpperBoundValid( type ) ) {
+        subcon.pruneSingleScans( network_, sourceList_, parameters_.candidatePruningFactor * lastBestScore_ );
+    }
     subcon.updateAzEl( network_, sourceList_ );
-    subcon.constructAllBaselines( network_, sourceList_ );
-    subcon.calcAllBaselineDurations( network_, sourceList_, currentObservingMode_ );
-    subcon.calcAllScanDurations( network_, sourceList_, endposition );
-    subcon.checkTotalObservingTime( network_, sourceList_ );
-    subcon.checkIfEnoughTimeToReachEndposition( network_, sourceList_, endposition );
+    durationCache_.resize( network_.getNBls(), sourceList_.getNSrc() );
+    subcon.finishSingleScans( network_, sourceList_, currentObservingMode_, endposition,
+                              DurationCache::enabled ? &durationCache_ : nullptr );
 
     if ( subnetting != nullptr ) {
         subcon.createSubnettingScans( subnetting, network_, sourceList_ );
@@ -665,9 +719,11 @@ Subcon Scheduler::allVisibleScans( Scan::ScanType type, const boost::optional<St
     if ( Flags::logDebug ) BOOST_LOG_TRIVIAL( debug ) << "creating new subcon " << subcon.printId();
 #endif
 
+    candidateCache_.resize( network_.getNSta(), sourceList_.getNSrc() );
+    subcon.setScanPool( &scanPool_ );
     for ( const auto &thisSource : sourceList_.getSources() ) {
         subcon.visibleScan( currentTime, type, network_, thisSource, observedSources,
-                            doNotObserveSourcesWithinMinRepeat );
+                            doNotObserveSourcesWithinMinRepeat, &candidateCache_ );
     }
 
     return subcon;
@@ -711,7 +767,7 @@ void Scheduler::update( Scan &scan, ofstream &of ) noexcept {
         if ( sta.getPARA().dataWriteRate.is_initialized() ) {
             //            double recRate = currentObservingMode_->recordingRate( staid );
             unsigned int duration = scan.getTimes().getObservingDuration( i );
-            sta.referencePARA().overheadTimeDueToDataWriteSpeed( duration );
+            sta.overheadTimeDueToDataWriteSpeed( duration );
         }
     }
 
@@ -720,7 +776,8 @@ void Scheduler::update( Scan &scan, ofstream &of ) noexcept {
 }
 
 
-void Scheduler::consideredUpdate( unsigned long n1scans, unsigned long n2scans, int depth, ofstream &of ) noexcept {
+void Scheduler::consideredUpdate( unsigned long n1scans, unsigned long n2scans, int depth, ofstream &of,
+                                  unsigned long nPruned ) noexcept {
     if ( n1scans + n2scans > 0 ) {
         string right;
         if ( n2scans == 0 ) {
@@ -728,9 +785,13 @@ void Scheduler::consideredUpdate( unsigned long n1scans, unsigned long n2scans,
         } else {
             right = ( boost::format( "considered single scans %d, subnetting scans %d" ) % n1scans % n2scans ).str();
         }
+        if ( nPruned > 0 ) {
+            right.append( ( boost::format( " (pruned %d)" ) % nPruned ).str() );
+        }
         of << boost::format( "| depth:  %d %130s |\n" ) % depth % right;
         nSingleScansConsidered += n1scans;
         nSubnettingScansConsidered += n2scans;
+        nSingleScansPruned += nPruned;
     }
 }
 
@@ -763,7 +824,7 @@ bool Scheduler::checkAndStatistics( ofstream &of ) noexcept {
         of << "    checking station " << thisStation.getName() << ":\n";
         unsigned long staid = thisStation.getId();
         unsigned int constTimes = thisStation.getPARA().systemDelay + thisStation.getPARA().preob;
-        thisStation.referencePARA().firstScan = false;
+        thisStation.setFirstScan( false );
 
         // sort scans based on observation start of this station (can be different if you align scans individual or at
         // end)
@@ -1311,15 +1372,15 @@ void Scheduler::startTagelongMode( Station &station, SkyCoverage &skyCoverage, s
                 } else if ( source->getPARA().forceSameObservingDuration ) {
                     maxScanDuration = scan.getTimes().getObservingDuration();
                 } else {
-                    for ( auto &band : currentObservingMode_->getAllBands() ) {
+                    for ( unsigned long bandId : currentObservingMode_->getAllBandIds() ) {
                         double SEFD_src;
-                        if ( source->hasFluxInformation( band ) ) {
+                        if ( source->hasFluxInformation( bandId ) ) {
                             // calculate observed flux density for each band
-                            SEFD_src = source->observedFlux( band, scanStartTime, gmst,
+                            SEFD_src = source->observedFlux( bandId, scanStartTime, gmst,
                                                              network_.getDxyz( sta1.getId(), sta2.getId() ) );
-                        } else if ( ObservingMode::sourceBackup[band] == ObservingMode::Backup::internalModel ) {
+                        } else if ( ObservingMode::sourceBackupIsInternalModel( bandId ) ) {
                             // calculate observed flux density based on model
-                            double wavelength = ObservingMode::wavelengths[band];
+                            double wavelength = ObservingMode::wavelength( bandId );
                             SEFD_src = source->observedFlux_model( wavelength, scanStartTime, gmst,
                                                                    network_.getDxyz( sta1.getId(), sta2.getId() ) );
                         } else {
@@ -1327,17 +1388,17 @@ void Scheduler::startTagelongMode( Station &station, SkyCoverage &skyCoverage, s
                         }
 
                         double el1 = pv_new_start.getEl();
-                        double SEFD_sta1 = sta1.getEquip().getSEFD( band, el1 );
+                        double SEFD_sta1 = sta1.getEquip().getSEFD( bandId, el1 );
 
                         double el2 = otherPv.getEl();
-                        double SEFD_sta2 = sta2.getEquip().getSEFD( band, el2 );
+                        double SEFD_sta2 = sta2.getEquip().getSEFD( bandId, el2 );
 
-                        double minSNR_sta1 = sta1.getPARA().minSNR.at( band );
-                        double minSNR_sta2 = sta2.getPARA().minSNR.at( band );
+                        double minSNR_sta1 = sta1.getPARA().minSNR.at( bandId );
+                        double minSNR_sta2 = sta2.getPARA().minSNR.at( bandId );
 
-                        double minSNR_bl = bl.getParameters().minSNR.at( band );
+                        double minSNR_bl = bl.getParameters().minSNR.at( bandId );
 
-                        double minSNR_src = source->getPARA().minSNR.at( band );
+                        double minSNR_src = source->getPARA().minSNR.at( bandId );
 
                         double maxminSNR = minSNR_src;
                         if ( minSNR_sta1 > maxminSNR ) {
@@ -1360,7 +1421,7 @@ void Scheduler::startTagelongMode( Station &station, SkyCoverage &skyCoverage, s
                         double efficiency = currentObservingMode_->efficiency( sta1.getId(), sta2.getId() );
                         double anum = ( maxminSNR / ( SEFD_src * efficiency ) );
                         double anu1 = SEFD_sta1 * SEFD_sta2;
-                        double anu2 = currentObservingMode_->recordingRate( sta1.getId(), sta2.getId(), band );
+                        double anu2 = currentObservingMode_->recordingRate( sta1.getId(), sta2.getId(), bandId );
 
                         double new_duration = anum * anum * anu1 / anu2 + maxCorSynch;
                         new_duration = ceil( new_duration );
@@ -1510,8 +1571,8 @@ void Scheduler::startTagelongMode( Station &station, SkyCoverage &skyCoverage, s
 #endif
 
             of << txt;
-            if ( station.referencePARA().firstScan ) {
-                station.referencePARA().firstScan = false;
+            if ( station.getPARA().firstScan ) {
+                station.setFirstScan( false );
             }
 
             station.addObservingTime( obsDur );
@@ -1706,14 +1767,13 @@ void Scheduler::changeStationAvailability( const boost::optional<StationEndposit
     switch ( change ) {
         case StationEndposition::change::start: {
             for ( auto &sta : network_.refStations() ) {
-                sta.referencePARA().available = endposition->getStationPossible( sta.getId() );
+                sta.setAvailable( endposition->getStationPossible( sta.getId() ) );
             }
             break;
         }
         case StationEndposition::change::end: {
             for ( auto &sta : network_.refStations() ) {
-                sta.referencePARA().available =
-                    endposition->getStationAvailable( sta.getId() ) || sta.getPARA().available;
+                sta.setAvailable( endposition->getStationAvailable( sta.getId() ) || sta.getPARA().available );
             }
             break;
         }
@@ -1761,7 +1821,7 @@ void Scheduler::startScanSelectionBetweenScans( unsigned int duration, std::ofst
     // ####### FIRST SCAN #######
     // look through all stations and set first scan to true
     for ( auto &thisSta : network_.refStations() ) {
-        thisSta.referencePARA().firstScan = true;
+        thisSta.setFirstScan( true );
     }
     // loop through all upcoming scans and set endposition
     boost::optional<StationEndposition> endposition( network_.getNSta() );
@@ -1804,7 +1864,7 @@ void Scheduler::startScanSelectionBetweenScans( unsigned int duration, std::ofst
         const auto &sta = network_.getStation( staid );
         for ( int j = scans_.size() - 1; j >= nMainScans; --j ) {
             const Scan &tmp = scans_[j];
-            if ( tmp.findIdxOfStationId( staid ).is_initialized() ) {
+            if ( tmp.hasStation( staid ) ) {
                 int idx2 = *tmp.findIdxOfStationId( staid );
                 const PointingVector &pv_slew_start = tmp.getPointingVector( idx2, Timestamp::end );
                 boost::optional<unsigned int> oSlewTime = sta.slewTime( pv_slew_start, pv_slew_end );
@@ -1872,8 +1932,8 @@ void Scheduler::startScanSelectionBetweenScans( unsigned int duration, std::ofst
             Station &thisSta = network_.refStation( staid );
             if ( time >= thisSta.getCurrentTime() ) {
                 thisSta.setCurrentPointingVector( pv );
-                thisSta.referencePARA().firstScan = false;
-                thisSta.referencePARA().overheadTimeDueToDataWriteSpeed(
+                thisSta.setFirstScan( false );
+                thisSta.overheadTimeDueToDataWriteSpeed(
                         lastScan.getTimes().getObservingDuration(k));
             }
         }
@@ -1941,7 +2001,7 @@ void Scheduler::startScanSelectionBetweenScans( unsigned int duration, std::ofst
                 pv_slew_start.setTime( 0 );
                 for ( int j = i; j >= 0; --j ) {
                     const Scan &tmp = scans_[j];
-                    if ( tmp.findIdxOfStationId( staid ).is_initialized() ) {
+                    if ( tmp.hasStation( staid ) ) {
                         int idx2 = *tmp.findIdxOfStationId( staid );
                         const PointingVector &tmp_pv = tmp.getPointingVector( idx2, Timestamp::end );
                         if ( tmp_pv.getTime() < pv_slew_end.getTime() ) {
@@ -1953,7 +2013,7 @@ void Scheduler::startScanSelectionBetweenScans( unsigned int duration, std::ofst
                 }
                 for ( int j = scans_.size() - 1; j >= nMainScans; --j ) {
                     const Scan &tmp = scans_[j];
-                    if ( tmp.findIdxOfStationId( staid ).is_initialized() ) {
+                    if ( tmp.hasStation( staid ) ) {
                         int idx2 = *tmp.findIdxOfStationId( staid );
                         const PointingVector &pv_slew_start_2 = tmp.getPointingVector( idx2, Timestamp::end );
                         if ( pv_slew_start.getTime() < pv_slew_start_2.getTime() ) {
@@ -2025,7 +2085,7 @@ void Scheduler::calibratorBlocks( std::ofstream &of ) {
                 PointingVector pv( thisStation.getCurrentPointingVector() );
                 pv.setTime( time );
                 thisStation.setCurrentPointingVector( pv );
-                thisStation.referencePARA().firstScan = true;
+                thisStation.setFirstScan( true );
             }
 
             // start scheduling
@@ -2137,7 +2197,7 @@ void Scheduler::parallacticAngleBlocks( ofstream &of ) {
             PointingVector pv( thisStation.getCurrentPointingVector() );
             pv.setTime( time );
             thisStation.setCurrentPointingVector( pv );
-            thisStation.referencePARA().firstScan = true;
+            thisStation.setFirstScan( true );
         }
 
         Subcon subcon = createSubcon( nullptr, Scan::ScanType::parallacticAngle );
@@ -2227,7 +2287,7 @@ void Scheduler::differentialParallacticAngleBlocks( ofstream &of ) {
             PointingVector pv( thisStation.getCurrentPointingVector() );
             pv.setTime( time );
             thisStation.setCurrentPointingVector( pv );
-            thisStation.referencePARA().firstScan = true;
+            thisStation.setFirstScan( true );
         }
 
         Subcon subcon = createSubcon( nullptr, Scan::ScanType::diffParallacticAngle );
@@ -2301,7 +2361,7 @@ void Scheduler::highImpactScans( HighImpactScanDescriptor &himp, ofstream &of )
             pv.setAz( ( thisStation.getCableWrap().getNLow() + thisStation.getCableWrap().getNUp() ) / 2 );
             pv.setEl( 0 );
             thisStation.setCurrentPointingVector( pv );
-            thisStation.referencePARA().firstScan = true;
+            thisStation.setFirstScan( true );
         }
 
         // create all possible high impact scan pointing vectors for this time
@@ -2323,7 +2383,7 @@ void Scheduler::highImpactScans( HighImpactScanDescriptor &himp, ofstream &of )
                 update( scan, of );
 
                 for ( auto &thisStation : network_.refStations() ) {
-                    thisStation.referencePARA().firstScan = true;
+                    thisStation.setFirstScan( true );
                 }
             }
         }
@@ -2346,7 +2406,7 @@ void Scheduler::highImpactScans( HighImpactScanDescriptor &himp, ofstream &of )
         pv.setAz( ( thisStation.getCableWrap().getNLow() + thisStation.getCableWrap().getNUp() ) / 2 );
         pv.setEl( 0 );
         thisStation.setCurrentPointingVector( pv );
-        thisStation.referencePARA().firstScan = true;
+        thisStation.setFirstScan( true );
     }
 }
 
@@ -2376,7 +2436,7 @@ void Scheduler::resetAllEvents( std::ofstream &of, bool resetCurrentPointingVect
     checkForNewEvents( 0, false, of, false );
     if ( resetCurrentPointingVector ){
         for ( auto &any : network_.refStations() ) {
-            any.referencePARA().firstScan = true;
+            any.setFirstScan( true );
         }
     }
 }
@@ -2437,7 +2497,7 @@ void Scheduler::idleToScanTime( Timestamp ts, std::ofstream &of ) {
             auto &scan1 = scans_[iscan1];
 
             // skip scan if it does not contain this station
-            if ( !scan1.findIdxOfStationId( staid ).is_initialized() ) {
+            if ( !scan1.hasStation( staid ) ) {
                 continue;
             }
 
@@ -2488,7 +2548,7 @@ void Scheduler::idleToScanTime( Timestamp ts, std::ofstream &of ) {
 
             // look for index of next scan with this station
             int iscan2 = iscan1 + 1;
-            while ( iscan2 < scans_.size() && !scans_[iscan2].findIdxOfStationId( staid ).is_initialized() ) {
+            while ( iscan2 < scans_.size() && !scans_[iscan2].hasStation( staid ) ) {
                 ++iscan2;
             }
 
@@ -87,6 +87,9 @@ class Scheduler : public VieVS_NamedObject {
         bool doNotObserveSourcesWithinMinRepeat =
             true;  ///< consider scans (with reduced weight) if they are within min repeat time
 
+        bool candidatePruning = false;        ///< prune scan candidates which can not reach the previous best score
+        double candidatePruningFactor = 0.5;  ///< fraction of previous best score used as pruning threshold
+
         bool writeSkyCoverageData = false;  ///< flag if sky coverage data should be printed to file
     };
 
@@ -177,8 +180,10 @@ class Scheduler : public VieVS_NamedObject {
      * @param n2scans number of subnetting scans
      * @param depth recursion depth
      * @param of outstream file object
+     * @param nPruned number of pruned single source scans
      */
-    void consideredUpdate( unsigned long n1scans, unsigned long n2scans, int depth, std::ofstream &of ) noexcept;
+    void consideredUpdate( unsigned long n1scans, unsigned long n2scans, int depth, std::ofstream &of,
+                           unsigned long nPruned = 0 ) noexcept;
 
 
     /**
@@ -304,6 +309,13 @@ class Scheduler : public VieVS_NamedObject {
     unsigned long nSingleScansConsidered = 0;      ///< considered single source scans
     unsigned long nSubnettingScansConsidered = 0;  ///< considered subnetting scans
     unsigned long nObservationsConsidered = 0;     ///< considered baselines
+    unsigned long nSingleScansPruned = 0;          ///< pruned single source scans
+    unsigned long nPrunedScansRestored = 0;        ///< scan selections where pruned scans had to be restored
+    double lastBestScore_ = 0;                     ///< score of previously selected standard scan
+
+    CandidateCache candidateCache_;  ///< station/source partial results reused between scan selections
+    ScanPool scanPool_;              ///< released scan buffers reused between scan selections
+    DurationCache durationCache_;    ///< required observing durations reused between scan selections
 
     boost::optional<HighImpactScanDescriptor> himp_;                          ///< high impact scan descriptor
     std::vector<CalibratorBlock> calib_;                                      ///< fringeFinder impact scan descriptor
@@ -177,7 +177,7 @@ void Simulator::simTropo() {
 
         unsigned int c = 0;
         for ( const auto &any : scans_ ) {
-            if ( any.findIdxOfStationId( staid ).is_initialized() ) {
+            if ( any.hasStation( staid ) ) {
                 PointingVector pv = any.getPointingVector( *any.findIdxOfStationId( staid ) );
                 ++tn( pv.getTime() / ( simpara.tropo_dhseg * 3600 ) );
                 pvs.push_back( pv );
@@ -188,7 +188,7 @@ void Simulator::simTropo() {
         VectorXd mfw = VectorXd::Zero( c );
         c = 0;
         for ( const auto &any : scans_ ) {
-            if ( any.findIdxOfStationId( staid ).is_initialized() ) {
+            if ( any.hasStation( staid ) ) {
                 PointingVector pv = any.getPointingVector( *any.findIdxOfStationId( staid ) );
                 mfw( c ) = 1 / sin( pv.getEl() );
                 ++c;
@@ -438,7 +438,7 @@ void Simulator::simTropoDummy() {
     for ( int staid = 0; staid < nsta; ++staid ) {
         int counter = 0;
         for ( const auto &any : scans_ ) {
-            if ( any.findIdxOfStationId( staid ).is_initialized() ) {
+            if ( any.hasStation( staid ) ) {
                 ++counter;
             }
         }
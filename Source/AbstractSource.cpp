@@ -76,6 +76,15 @@ AbstractSource::AbstractSource( const string &src_name, const string &src_name2,
     : VieVS_NamedObject( src_name, src_name2, nextId++ ), parameters_{ Parameters( "empty" ) } {
     flux_ = std::make_shared<std::unordered_map<std::string, std::unique_ptr<AbstractFlux>>>( std::move( src_flux ) );
 
+    fluxById_ = std::make_shared<std::vector<const AbstractFlux *>>();
+    for ( const auto &any : *flux_ ) {
+        unsigned long bandId = BandRegistry::id( any.first );
+        if ( bandId >= fluxById_->size() ) {
+            fluxById_->resize( bandId + 1, nullptr );
+        }
+        ( *fluxById_ )[bandId] = any.second.get();
+    }
+
     condition_ = make_shared<Optimization>( Optimization() );
 }
 
@@ -113,10 +122,7 @@ double AbstractSource::getMaxFlux() const noexcept {
 
 double AbstractSource::getSunDistance( unsigned int time,
                                        const std::shared_ptr<const Position> &sta_pos ) const noexcept {
-    unsigned int precalc_idx = 0;
-    while ( AstronomicalParameters::sun_time[precalc_idx + 1] < time ) {
-        ++precalc_idx;
-    }
+    unsigned int precalc_idx = AstronomicalParameters::getSunInterpolationIdx( time );
     unsigned int delta = AstronomicalParameters::sun_time[1] - AstronomicalParameters::sun_time[0];
 
     unsigned int deltaTime = time - AstronomicalParameters::sun_time[precalc_idx];
@@ -153,22 +159,54 @@ double AbstractSource::observedFlux( const string &band, unsigned int time, doub
 }
 
 
+double AbstractSource::observedFlux( unsigned long bandId, unsigned int time, double gmst,
+                                     const std::vector<double> &dxyz ) const noexcept {
+#ifdef VIESCHEDPP_LOG
+    if ( Flags::logTrace ) BOOST_LOG_TRIVIAL( trace ) << "source " << this->getName() << " get observed flux density";
+#endif
+
+    const AbstractFlux *thisFlux = ( *fluxById_ )[bandId];
+    if ( thisFlux->needsUV() ) {
+        std::pair<double, double> uv = calcUV( time, gmst, dxyz );
+        return thisFlux->observedFlux( uv.first, uv.second );
+    }
+    return thisFlux->observedFlux( 0, 0 );
+}
+
+
+void AbstractSource::observedFluxes( unsigned long bandId, unsigned long n, const double *u, const double *v,
+                                     double *flux ) const noexcept {
+#ifdef VIESCHEDPP_LOG
+    if ( Flags::logTrace ) BOOST_LOG_TRIVIAL( trace ) << "source " << this->getName() << " get observed flux densities";
+#endif
+
+    const AbstractFlux *thisFlux = ( *fluxById_ )[bandId];
+    if ( thisFlux->needsUV() ) {
+        thisFlux->observedFluxes( n, u, v, flux );
+    } else {
+        fill( flux, flux + n, thisFlux->observedFlux( 0, 0 ) );
+    }
+}
+
+
 std::pair<double, double> AbstractSource::calcUV( unsigned int time, double gmst,
                                                   const std::vector<double> &dxyz ) const noexcept {
+    return calcUV( calcUVProjection( time, gmst ), dxyz );
+};
+
+
+AbstractSource::UVProjection AbstractSource::calcUVProjection( unsigned int time, double gmst ) const noexcept {
     auto srcRaDe = getRaDe( time, nullptr );
     double ha = gmst - srcRaDe.first;
     double de = srcRaDe.second;
 
-    double sinHa = sin( ha );
-    double cosHa = cos( ha );
-    double cosDe = cos( de );
-    double sinDe = sin( de );
-
-
-    double u = dxyz[0] * sinHa + dxyz[1] * cosHa;
-    double v = dxyz[2] * cosDe + sinDe * ( -dxyz[0] * cosHa + dxyz[1] * sinHa );
-    return { u, v };
-};
+    UVProjection projection;
+    projection.sinHa = sin( ha );
+    projection.cosHa = cos( ha );
+    projection.cosDe = cos( de );
+    projection.sinDe = sin( de );
+    return projection;
+}
 
 
 void AbstractSource::update( unsigned long nsta, unsigned long nbl, unsigned int time, bool addToStatistics ) noexcept {
@@ -28,6 +28,7 @@
 #define SOURCE_H
 
 
+#include <algorithm>
 #include <boost/format.hpp>
 #include <boost/optional.hpp>
 #include <cmath>
@@ -38,6 +39,7 @@
 #include <utility>
 
 #include "../Misc/AstronomicalParameters.h"
+#include "../Misc/BandRegistry.h"
 #include "../Misc/Constants.h"
 #include "../Misc/Flags.h"
 #include "../Misc/TimeSystem.h"
@@ -110,7 +112,7 @@ class AbstractSource : public VieVS_NamedObject {
 
         double weight = 1;  ///< multiplicative factor of score for scans to this source
 
-        std::unordered_map<std::string, double> minSNR;  ///< minimum required signal to noise ration for each band
+        BandMap<double> minSNR;  ///< minimum required signal to noise ration for each band
 
         unsigned int minNumberOfStations = 3;  ///< minimum number of stations for a scan
         double minFlux = 0.001;                ///< minimum flux density required for this source in jansky
@@ -471,6 +473,16 @@ class AbstractSource : public VieVS_NamedObject {
      */
     void setNextEvent( unsigned int nextEvent ) { AbstractSource::nextEvent_ = nextEvent; }
 
+    /**
+     * @brief get next event index
+     * @author Matthias Schartner
+     *
+     * parameters set by events only change if this index changes
+     *
+     * @return next event index
+     */
+    unsigned int getNextEvent() const noexcept { return nextEvent_; }
+
 
     /**
      * @brief get maxium possible flux density
@@ -503,6 +515,35 @@ class AbstractSource : public VieVS_NamedObject {
                          const std::vector<double> &dxyz ) const noexcept;
 
 
+    /**
+     * @brief observed flux density per band
+     * @author Matthias Schartner
+     *
+     * @param bandId observed band id
+     * @param gmst greenwhich meridian sedirial time
+     * @param dxyz coordinate difference of participating stations
+     * @return observed flux density per band
+     */
+    double observedFlux( unsigned long bandId, unsigned int time, double gmst,
+                         const std::vector<double> &dxyz ) const noexcept;
+
+
+    /**
+     * @brief observed flux density of one band for multiple projected baselines
+     * @author Matthias Schartner
+     *
+     * requires flux information of this band (see hasFluxInformation())
+     *
+     * @param bandId observed band id
+     * @param n number of projected baselines
+     * @param u projected baseline lengths u (see calcUV())
+     * @param v projected baseline lengths v (see calcUV())
+     * @param flux observed flux density per baseline
+     */
+    void observedFluxes( unsigned long bandId, unsigned long n, const double *u, const double *v,
+                         double *flux ) const noexcept;
+
+
     /**
      * @brief calc projection of baseline in uv plane
      * @author Matthias Schartner
@@ -513,6 +554,43 @@ class AbstractSource : public VieVS_NamedObject {
      */
     std::pair<double, double> calcUV( unsigned int time, double gmst, const std::vector<double> &dxyz ) const noexcept;
 
+    /**
+     * @brief hour angle and declination trigonometry required for projection of baselines in uv plane
+     * @author Matthias Schartner
+     */
+    struct UVProjection {
+        double sinHa = 0;  ///< sine of hour angle
+        double cosHa = 1;  ///< cosine of hour angle
+        double sinDe = 0;  ///< sine of declination
+        double cosDe = 1;  ///< cosine of declination
+    };
+
+    /**
+     * @brief calc hour angle and declination trigonometry, can be shared by all baselines observed at this time
+     * @author Matthias Schartner
+     *
+     * @param time time since session start
+     * @param gmst greenwich mean sidereal time
+     * @return projection into uv plane
+     */
+    UVProjection calcUVProjection( unsigned int time, double gmst ) const noexcept;
+
+    /**
+     * @brief calc projection of baseline in uv plane
+     * @author Matthias Schartner
+     *
+     * @param projection hour angle and declination trigonometry
+     * @param dxyz baseline vector
+     * @return projection of baseline vector in uv plane
+     */
+    static std::pair<double, double> calcUV( const UVProjection &projection,
+                                             const std::vector<double> &dxyz ) noexcept {
+        double u = dxyz[0] * projection.sinHa + dxyz[1] * projection.cosHa;
+        double v = dxyz[2] * projection.cosDe +
+                   projection.sinDe * ( -dxyz[0] * projection.cosHa + dxyz[1] * projection.sinHa );
+        return { u, v };
+    }
+
     /**
      * @brief check if observations along jet angle should be investigated
      * @author Matthias Schartner
@@ -604,11 +682,23 @@ class AbstractSource : public VieVS_NamedObject {
      */
     bool hasFluxInformation( const std::string &band ) const { return flux_->find( band ) != flux_->end(); }
 
+    /**
+     * @brief checks if flux information is available
+     * @author Matthias Schartner
+     *
+     * @param bandId band id
+     * @return true if flux information is available, otherwise false
+     */
+    bool hasFluxInformation( unsigned long bandId ) const noexcept {
+        return bandId < fluxById_->size() && ( *fluxById_ )[bandId] != nullptr;
+    }
+
    private:
     static unsigned long nextId;  ///< next id for this object type
 
     std::shared_ptr<std::unordered_map<std::string, std::unique_ptr<AbstractFlux>>>
         flux_;                                      ///< source flux information per band
+    std::shared_ptr<std::vector<const AbstractFlux *>> fluxById_;  ///< source flux information per band id
     std::vector<Event> events_;    ///< list of all events
     std::shared_ptr<Optimization> condition_;       ///< optimization conditions
     Statistics statistics_;                         ///< statistics
@@ -84,6 +84,21 @@ class AbstractFlux : public VieVS_Object {
      */
     virtual double observedFlux( double u, double v ) const noexcept = 0;
 
+    /**
+     * @brief flux density based on uv for multiple projected baselines
+     * @author Matthias Schartner
+     *
+     * @param n number of projected baselines
+     * @param u projected baseline lengths
+     * @param v projected baseline lengths
+     * @param flux flux density for each constellation
+     */
+    virtual void observedFluxes( unsigned long n, const double *u, const double *v, double *flux ) const noexcept {
+        for ( unsigned long i = 0; i < n; ++i ) {
+            flux[i] = observedFlux( u[i], v[i] );
+        }
+    }
+
     /**
      * @brief returns true if flux model needs UV information to calculate flux density
      * @author Matthias Schartner
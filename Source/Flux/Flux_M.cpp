@@ -31,7 +31,12 @@ VieVS::Flux_M::Flux_M( double wavelength, std::vector<double> flux, std::vector<
       flux_{ std::move( flux ) },
       majorAxis_{ std::move( majorAxis ) },
       axialRatio_{ std::move( axialRatio ) },
-      positionAngle_{ std::move( positionAngle ) } {}
+      positionAngle_{ std::move( positionAngle ) } {
+    for ( double pa : positionAngle_ ) {
+        cosPa_.push_back( cos( pa ) );
+        sinPa_.push_back( sin( pa ) );
+    }
+}
 
 
 double Flux_M::getMaximumFlux() const noexcept {
@@ -54,11 +59,10 @@ double Flux_M::observedFlux( double u, double v ) const noexcept {
     double v_w = v / AbstractFlux::getWavelength();
 
     for ( int i = 0; i < flux_.size(); ++i ) {
-        double pa = positionAngle_[i];
-        double ucospa = u_w * cos( pa );
-        double usinpa = u_w * sin( pa );
-        double vcospa = v_w * cos( pa );
-        double vsinpa = v_w * sin( pa );
+        double ucospa = u_w * cosPa_[i];
+        double usinpa = u_w * sinPa_[i];
+        double vcospa = v_w * cosPa_[i];
+        double vsinpa = v_w * sinPa_[i];
 
         double arg1 = ( vcospa + usinpa ) * ( vcospa + usinpa );
         double arg2 = ( axialRatio_[i] * ( ucospa - vsinpa ) ) * ( axialRatio_[i] * ( ucospa - vsinpa ) );
@@ -70,6 +74,42 @@ double Flux_M::observedFlux( double u, double v ) const noexcept {
     return observedFlux;
 }
 
+
+void Flux_M::observedFluxes( unsigned long n, const double *u, const double *v, double *flux ) const noexcept {
+    double wavelength = AbstractFlux::getWavelength();
+    unsigned long nComponents = flux_.size();
+    const double *componentFlux = flux_.data();
+    const double *majorAxis = majorAxis_.data();
+    const double *axialRatio = axialRatio_.data();
+    const double *cosPa = cosPa_.data();
+    const double *sinPa = sinPa_.data();
+
+    for ( unsigned long j = 0; j < n; ++j ) {
+        flux[j] = 0;
+    }
+
+    // components in outer loop, baselines in inner (vectorizable) loop
+    for ( unsigned long i = 0; i < nComponents; ++i ) {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+        for ( unsigned long j = 0; j < n; ++j ) {
+            double u_w = u[j] / wavelength;
+            double v_w = v[j] / wavelength;
+
+            double ucospa = u_w * cosPa[i];
+            double usinpa = u_w * sinPa[i];
+            double vcospa = v_w * cosPa[i];
+            double vsinpa = v_w * sinPa[i];
+
+            double arg1 = ( vcospa + usinpa ) * ( vcospa + usinpa );
+            double arg2 = ( axialRatio[i] * ( ucospa - vsinpa ) ) * ( axialRatio[i] * ( ucospa - vsinpa ) );
+            double arg = -flcon1_ * ( arg1 + arg2 ) * majorAxis[i] * majorAxis[i];
+            flux[j] += componentFlux[i] * exp( arg );
+        }
+    }
+}
+
 // Flux_M *Flux_M::do_clone() const {
 //    return new Flux_M(*this);
 //}
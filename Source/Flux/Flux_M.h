@@ -76,6 +76,19 @@ class Flux_M : public AbstractFlux {
      */
     double observedFlux( double u, double v ) const noexcept override;
 
+    /**
+     * @brief observed flux density for multiple projected baselines
+     * @author Matthias Schartner
+     *
+     * Components are evaluated one after another, the inner loop over all baselines is written for vectorization.
+     *
+     * @param n number of projected baselines
+     * @param u projected baseline lengths u
+     * @param v projected baseline lengths v
+     * @param flux observed flux density in jansky per baseline
+     */
+    void observedFluxes( unsigned long n, const double *u, const double *v, double *flux ) const noexcept override;
+
 
     /**
      * @brief returns true if flux model needs UV information to calculate flux density
@@ -90,6 +103,8 @@ class Flux_M : public AbstractFlux {
     std::vector<double> majorAxis_;      ///< major axis angle
     std::vector<double> axialRatio_;     ///< axial ratio
     std::vector<double> positionAngle_;  ///< position angle
+    std::vector<double> cosPa_;          ///< cosine of position angle
+    std::vector<double> sinPa_;          ///< sine of position angle
 
     static double flcon1_;  ///< constant precalculated value
     //        static double flcon2_; ///< constant precalculated value
@@ -18,9 +18,15 @@
 
 #include "Satellite.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace VieVS;
 
+unsigned int VieVS::Satellite::ephemerisStep = 30;
+
 Satellite::Satellite( const std::string& hdr, const std::string& l1, const std::string& l2,
                       unordered_map<std::string, std::unique_ptr<AbstractFlux>>& src_flux )
     : AbstractSource( hdr, util::simplify( hdr ), src_flux ),
@@ -29,6 +35,7 @@ Satellite::Satellite( const std::string& hdr, const std::string& l1, const std::
       line2_{ l2 } {
     auto epoch = extractReferenceEpoch(l1);
     pSGP4Data_.emplace_back( std::make_pair(epoch, SGP4(Tle(hdr, l1, l2))));
+    tleData_.push_back( { { hdr, l1, l2 } } );
 //    string tmp = TimeSystem::time2string(epoch);
 //    std::cout << tmp;
 }
@@ -41,28 +48,111 @@ std::vector<double> Satellite::getSourceInCrs( unsigned int time,
     return { cosDe * cos( srcRaDe.first ), cosDe * sin( srcRaDe.first ), sin( srcRaDe.second ) };
 }
 
-pair<double, double> Satellite::calcRaDe( unsigned int time, const std::shared_ptr<const Position>& sta_pos ) const {
-    DateTime currentTime = internalTime2sgpt4Time( time );
-    unsigned long idx = 0;
-    if(pSGP4Data_.size()>1){
-        boost::posix_time::ptime ref = TimeSystem::internalTime2PosixTime(time);
-        long dt = numeric_limits<long>::max();
-
-        for(int i = 0; i<pSGP4Data_.size(); ++i){
-            const auto &any = pSGP4Data_[i];
-//            string x = TimeSystem::time2string(any.first);
-//            string y = TimeSystem::time2string(ref);
-
-            long n = (any.first - ref).total_seconds();
-            n = abs(n);
-            if (n < dt){
-                idx = i;
-                dt = n;
+unsigned long Satellite::closestSGP4Data( unsigned int time ) const noexcept {
+    if ( pSGP4Data_.size() < 2 ) {
+        return 0;
+    }
+    boost::posix_time::ptime ref = TimeSystem::internalTime2PosixTime( time );
+    auto it = std::lower_bound(
+        pSGP4Data_.begin(), pSGP4Data_.end(), ref,
+        []( const pair<boost::posix_time::ptime, SGP4>& any, const boost::posix_time::ptime& t ) {
+            return any.first < t;
+        } );
+    if ( it == pSGP4Data_.end() ) {
+        return pSGP4Data_.size() - 1;
+    }
+    auto idx = static_cast<unsigned long>( distance( pSGP4Data_.begin(), it ) );
+    if ( idx == 0 ) {
+        return 0;
+    }
+    long after = ( it->first - ref ).total_seconds();
+    long before = ( ref - ( it - 1 )->first ).total_seconds();
+    return before <= after ? idx - 1 : idx;
+}
+
+
+void Satellite::precalcEphemeris( unsigned int end ) noexcept {
+    Ephemeris ephemeris;
+    ephemeris.step = ephemerisStep;
+    ephemeris.start = internalTime2sgpt4Time( 0 );
+    unsigned long n = end / ephemeris.step + 2;
+    ephemeris.position.reserve( n );
+    ephemeris.velocity.reserve( n );
+    try {
+        for ( unsigned long i = 0; i < n; ++i ) {
+            auto time = static_cast<unsigned int>( i * ephemeris.step );
+            Eci eci = sgp4Position( time, ephemeris.start );
+            ephemeris.position.push_back( eci.Position() );
+            ephemeris.velocity.push_back( eci.Velocity() );
+        }
+    } catch ( ... ) {
+        // keep propagating on demand, errors are reported there
+        ephemeris_ = Ephemeris();
+        return;
+    }
+    ephemeris_ = std::move( ephemeris );
+}
+
+
+Eci Satellite::findPosition( unsigned int time, const DateTime& dt ) const {
+    unsigned long i = ephemeris_.step == 0 ? 0 : time / ephemeris_.step;
+    if ( ephemeris_.step == 0 || i + 1 >= ephemeris_.position.size() ) {
+        return pSGP4Data_[closestSGP4Data( time )].second.FindPosition( dt );
+    }
+
+    // cubic Hermite interpolation between nodes i and i+1
+    double h = ephemeris_.step;
+    double s = ( time - i * ephemeris_.step ) / h;
+    double s2 = s * s;
+    double s3 = s2 * s;
+    double h00 = 2 * s3 - 3 * s2 + 1;
+    double h10 = ( s3 - 2 * s2 + s ) * h;
+    double h01 = -2 * s3 + 3 * s2;
+    double h11 = ( s3 - s2 ) * h;
+    double d00 = ( 6 * s2 - 6 * s ) / h;
+    double d10 = 3 * s2 - 4 * s + 1;
+    double d01 = ( -6 * s2 + 6 * s ) / h;
+    double d11 = 3 * s2 - 2 * s;
+
+    const Vector& p0 = ephemeris_.position[i];
+    const Vector& p1 = ephemeris_.position[i + 1];
+    const Vector& v0 = ephemeris_.velocity[i];
+    const Vector& v1 = ephemeris_.velocity[i + 1];
+    Vector position( h00 * p0.x + h10 * v0.x + h01 * p1.x + h11 * v1.x,
+                     h00 * p0.y + h10 * v0.y + h01 * p1.y + h11 * v1.y,
+                     h00 * p0.z + h10 * v0.z + h01 * p1.z + h11 * v1.z );
+    Vector velocity( d00 * p0.x + d10 * v0.x + d01 * p1.x + d11 * v1.x,
+                     d00 * p0.y + d10 * v0.y + d01 * p1.y + d11 * v1.y,
+                     d00 * p0.z + d10 * v0.z + d01 * p1.z + d11 * v1.z );
+    return Eci( dt, position, velocity );
+}
+
+
+std::vector<std::vector<Eci>> Satellite::propagate( const std::vector<std::shared_ptr<const Satellite>>& satellites,
+                                                     const std::vector<std::vector<unsigned int>>& times ) {
+    vector<vector<Eci>> states( satellites.size() );
+#ifdef _OPENMP
+#pragma omp parallel for schedule( dynamic ) if ( !omp_in_parallel() && satellites.size() > 1 )
+#endif
+    for ( int i = 0; i < static_cast<int>( satellites.size() ); ++i ) {
+        const auto& sat = *satellites[i];
+        DateTime start = internalTime2sgpt4Time( 0 );
+        vector<Eci>& thisStates = states[i];
+        thisStates.reserve( times[i].size() );
+        try {
+            for ( unsigned int t : times[i] ) {
+                thisStates.push_back( sat.sgp4Position( t, start ) );
             }
+        } catch ( ... ) {
+            thisStates.clear();
         }
     }
+    return states;
+}
+
 
-    Eci eci = pSGP4Data_[idx].second.FindPosition( currentTime );
+pair<double, double> Satellite::calcRaDe( const Eci& eci, const std::shared_ptr<const Position>& sta_pos ) {
+    DateTime currentTime = eci.GetDateTime();
     CoordGeodetic station;
     if ( sta_pos != nullptr ) {
         station = CoordGeodetic( sta_pos->getLat(), sta_pos->getLon(), sta_pos->getAltitude()/1000., true );
@@ -120,24 +210,37 @@ void Satellite::toVex( std::ofstream& of ) const {
 
 void Satellite::toVex( ofstream& of, const vector<unsigned int>& times,
                        const shared_ptr<const Position>& sta_pos ) const {
-    string eol = ";\n";
+    // same positions as batch propagation (exact SGP4 instead of interpolated ephemeris)
+    DateTime start = internalTime2sgpt4Time( 0 );
     for ( unsigned int t : times ) {
-        string name = getNameTime( t );
-        auto rade = getRaDe( t, sta_pos );
-
-        of << "    def " << name << eol;
-        of << "        source_type = star" << eol;
-        of << "        source_name = " << name << eol;
-        of << "        ra = " << getRaString( rade.first ) << eol;
-        of << "        dec = " << getDeString( rade.second ) << eol;
-        of << "        ref_coord_frame = J2000" << eol;
-        of << "        ra_rate = 0 asec/yr" << eol;
-        of << "        dec_rate = 0 asec/yr" << eol;
-        of << "    enddef;\n";
+        toVexTrackingDef( of, t, calcRaDe( sgp4Position( t, start ), sta_pos ) );
     }
 }
 
 
+void Satellite::toVex( ofstream& of, const vector<unsigned int>& times, const vector<Eci>& states,
+                       const shared_ptr<const Position>& sta_pos ) const {
+    for ( unsigned long i = 0; i < times.size(); ++i ) {
+        toVexTrackingDef( of, times[i], calcRaDe( states[i], sta_pos ) );
+    }
+}
+
+
+void Satellite::toVexTrackingDef( ofstream& of, unsigned int time, const pair<double, double>& rade ) const {
+    string eol = ";\n";
+    string name = getNameTime( time );
+    of << "    def " << name << eol;
+    of << "        source_type = star" << eol;
+    of << "        source_name = " << name << eol;
+    of << "        ra = " << getRaString( rade.first ) << eol;
+    of << "        dec = " << getDeString( rade.second ) << eol;
+    of << "        ref_coord_frame = J2000" << eol;
+    of << "        ra_rate = 0 asec/yr" << eol;
+    of << "        dec_rate = 0 asec/yr" << eol;
+    of << "    enddef;\n";
+}
+
+
 void Satellite::toNgsHeader( ofstream& of ) const {
     string name = getName();
     std::replace( name.begin(), name.end(), ' ', '_' );
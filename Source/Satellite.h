@@ -27,6 +27,8 @@
 #ifndef VIESCHEDPP_SATELLITE_H
 #define VIESCHEDPP_SATELLITE_H
 
+#include <algorithm>
+#include <array>
 #include <memory>
 #include <utility>
 
@@ -43,6 +45,7 @@ namespace VieVS {
 
 class Satellite : public AbstractSource {
    public:
+    static unsigned int ephemerisStep;  ///< time step of precalculated ephemeris in seconds
 
     /**
      * @brief constructor
@@ -76,18 +79,112 @@ class Satellite : public AbstractSource {
     void toVex( std::ofstream &of, const std::vector<unsigned int> &times,
                 const std::shared_ptr<const Position> &sta_pos ) const override;
 
+    /**
+     * @brief write vex $SOURCE entries for tracking using already propagated satellite states
+     * @author Matthias Schartner
+     *
+     * Same output as toVex(of, times, sta_pos). Both use SGP4 propagation at each tracking time and not the
+     * interpolated ephemeris (see precalcEphemeris()).
+     *
+     * @param of output stream
+     * @param times tracking times
+     * @param states satellite states at tracking times (see propagate())
+     * @param sta_pos observer position
+     */
+    void toVex( std::ofstream &of, const std::vector<unsigned int> &times, const std::vector<Eci> &states,
+                const std::shared_ptr<const Position> &sta_pos ) const;
+
     void toNgsHeader( std::ofstream &of ) const override;
 
-    std::pair<double, double> calcRaDe( unsigned int time, const std::shared_ptr<const Position> &sta_pos ) const;
+    std::pair<double, double> calcRaDe( unsigned int time, const std::shared_ptr<const Position> &sta_pos ) const {
+        return calcRaDe( getEci( time ), sta_pos );
+    }
+
 
+    /**
+     * @brief topocentric right ascension and declination for given satellite state
+     * @author Helene Wolf and Matthias Schartner
+     *
+     * @param eci satellite position and velocity
+     * @param sta_pos observer position
+     * @return right ascension and declination
+     */
+    static std::pair<double, double> calcRaDe( const Eci &eci, const std::shared_ptr<const Position> &sta_pos );
+
+
+    /**
+     * @brief batch propagation of satellites with SGP4
+     * @author Matthias Schartner
+     *
+     * Satellites are processed in parallel (OpenMP). The states are station independent and can be shared between
+     * all stations. If propagation of a satellite fails, its list of states is empty.
+     *
+     * @param satellites list of satellites
+     * @param times propagation times per satellite
+     * @return satellite states per satellite and time
+     */
+    static std::vector<std::vector<Eci>> propagate( const std::vector<std::shared_ptr<const Satellite>> &satellites,
+                                                    const std::vector<std::vector<unsigned int>> &times );
 
+
+    /**
+     * @brief satellite position and velocity in ECI frame
+     * @author Matthias Schartner
+     *
+     * uses precalculated ephemeris if available
+     *
+     * @param time time in seconds since session start
+     * @return satellite position and velocity
+     */
+    Eci getEci( unsigned int time ) const {
+        DateTime dt = ephemeris_.step == 0 ? internalTime2sgpt4Time( time )
+                                           : ephemeris_.start.AddSeconds( static_cast<double>( time ) );
+        return findPosition( time, dt );
+    }
+
+
+    /**
+     * @brief add additional TLE data set
+     * @author Helene Wolf and Matthias Schartner
+     *
+     * TLE data sets are kept sorted by reference epoch.
+     *
+     * @param hdr header line of TLE data
+     * @param l1 first line of TLE data
+     * @param l2 second line of TLE data
+     */
     void addpSGP4Data( const std::string &hdr, const std::string &l1, const std::string &l2 ) {
         auto epoch = extractReferenceEpoch( l1 );
-        pSGP4Data_.emplace_back( std::make_pair( epoch, SGP4( Tle( hdr, l1, l2 ) ) ) );
-        //        std::string tmp = TimeSystem::time2string(epoch);
-        //        std::cout << tmp;
+        auto it = std::upper_bound(
+            pSGP4Data_.begin(), pSGP4Data_.end(), epoch,
+            []( const boost::posix_time::ptime &t, const std::pair<boost::posix_time::ptime, SGP4> &any ) {
+                return t < any.first;
+            } );
+        tleData_.insert( tleData_.begin() + std::distance( pSGP4Data_.begin(), it ), { { hdr, l1, l2 } } );
+        pSGP4Data_.insert( it, std::make_pair( epoch, SGP4( Tle( hdr, l1, l2 ) ) ) );
+        ephemeris_ = Ephemeris();
     }
 
+
+    /**
+     * @brief propagate satellite orbit once for whole session
+     * @author Matthias Schartner
+     *
+     * Positions and velocities (ECI) are stored every ephemerisStep seconds using the closest TLE data set.
+     * calcRaDe() afterwards uses cubic Hermite interpolation instead of SGP4 propagation.
+     *
+     * @param end end time of ephemeris in seconds since session start
+     */
+    void precalcEphemeris( unsigned int end ) noexcept;
+
+    /**
+     * @brief getter for all TLE data sets
+     * @author Matthias Schartner
+     *
+     * @return header, first and second line of each TLE data set sorted by reference epoch
+     */
+    const std::vector<std::array<std::string, 3>> &getTleData() const noexcept { return tleData_; }
+
     std::string getNameTime( unsigned int t ) const {
         return ( boost::format( "%s<=>%s" ) % getName() % TimeSystem::time2string_doy_minus( t ) ).str();
     }
@@ -97,7 +194,63 @@ class Satellite : public AbstractSource {
     std::string header_;                                                ///< header line of TLE Data
     std::string line1_;                                                 ///< first line of TLE Data
     std::string line2_;                                                 ///< second line of TLE Data
-    std::vector<std::pair<boost::posix_time::ptime, SGP4>> pSGP4Data_;  ///< pointer to SGP4 Data + epoch
+    std::vector<std::pair<boost::posix_time::ptime, SGP4>> pSGP4Data_;  ///< SGP4 Data + epoch sorted by epoch
+    std::vector<std::array<std::string, 3>> tleData_;  ///< TLE data sets (same order as pSGP4Data_)
+
+    /**
+     * @brief precalculated satellite positions and velocities in ECI frame
+     * @author Matthias Schartner
+     */
+    struct Ephemeris {
+        unsigned int step = 0;         ///< time step in seconds
+        DateTime start;                ///< session start time
+        std::vector<Vector> position;  ///< satellite position in km
+        std::vector<Vector> velocity;  ///< satellite velocity in km/s
+    };
+    Ephemeris ephemeris_;  ///< precalculated ephemeris
+
+    /**
+     * @brief index of TLE data set with reference epoch closest to time
+     * @author Matthias Schartner
+     *
+     * binary search over sorted reference epochs, the earlier epoch is used in case of a tie
+     *
+     * @param time time in seconds since session start
+     * @return index in pSGP4Data_
+     */
+    unsigned long closestSGP4Data( unsigned int time ) const noexcept;
+
+    /**
+     * @brief satellite position and velocity in ECI frame
+     * @author Matthias Schartner
+     *
+     * @param time time in seconds since session start
+     * @param dt time
+     * @return satellite position and velocity
+     */
+    Eci findPosition( unsigned int time, const DateTime &dt ) const;
+
+    /**
+     * @brief satellite position and velocity in ECI frame propagated with SGP4 (without ephemeris interpolation)
+     * @author Matthias Schartner
+     *
+     * @param time time in seconds since session start
+     * @param start session start time
+     * @return satellite position and velocity
+     */
+    Eci sgp4Position( unsigned int time, const DateTime &start ) const {
+        return pSGP4Data_[closestSGP4Data( time )].second.FindPosition( start.AddSeconds( static_cast<double>( time ) ) );
+    }
+
+    /**
+     * @brief write one vex $SOURCE entry for tracking
+     * @author Matthias Schartner
+     *
+     * @param of output stream
+     * @param time tracking time
+     * @param rade topocentric right ascension and declination
+     */
+    void toVexTrackingDef( std::ofstream &of, unsigned int time, const std::pair<double, double> &rade ) const;
 
     static DateTime internalTime2sgpt4Time( unsigned int time ) {
         boost::posix_time::ptime ptime = TimeSystem::internalTime2PosixTime( time );
@@ -0,0 +1,228 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AzElCache.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+
+#include "../Misc/TimeSystem.h"
+#include "Station.h"
+
+
+using namespace std;
+using namespace VieVS;
+
+std::string VieVS::AzElCache::directory;
+constexpr char VieVS::AzElCache::magic_[8];
+
+
+namespace {
+/**
+ * @brief 64 bit FNV-1a hash
+ * @author Matthias Schartner
+ */
+class Fnv1a {
+   public:
+    void add( const void *data, size_t n ) noexcept {
+        const auto *p = static_cast<const unsigned char *>( data );
+        for ( size_t i = 0; i < n; ++i ) {
+            hash_ = ( hash_ ^ p[i] ) * 1099511628211ull;
+        }
+    }
+
+    void add( double v ) noexcept { add( &v, sizeof( v ) ); }
+
+    void add( unsigned long v ) noexcept {
+        auto v64 = static_cast<uint64_t>( v );
+        add( &v64, sizeof( v64 ) );
+    }
+
+    void add( const string &v ) noexcept {
+        add( static_cast<unsigned long>( v.size() ) );
+        add( v.data(), v.size() );
+    }
+
+    uint64_t get() const noexcept { return hash_; }
+
+   private:
+    uint64_t hash_ = 14695981039346656037ull;
+};
+}  // namespace
+
+
+AzElCache::AzElCache( const Station &station, const std::vector<std::shared_ptr<const Quasar>> &quasars,
+                      const std::vector<std::shared_ptr<const Satellite>> &satellites, unsigned int stepQuasar,
+                      unsigned int stepSatellite, unsigned int end ) {
+    Fnv1a hash;
+    hash.add( magic_, sizeof( magic_ ) );
+
+    const auto &pos = station.getPosition();
+    hash.add( station.getName() );
+    hash.add( pos->getX() );
+    hash.add( pos->getY() );
+    hash.add( pos->getZ() );
+
+    hash.add( TimeSystem::mjdStart );
+    hash.add( static_cast<unsigned long>( end ) );
+    hash.add( static_cast<unsigned long>( stepQuasar ) );
+    hash.add( static_cast<unsigned long>( stepSatellite ) );
+
+    for ( const auto &source : quasars ) {
+        hash.add( source->getId() );
+        hash.add( source->getName() );
+        for ( double v : source->getSourceInCrs() ) {
+            hash.add( v );
+        }
+    }
+    // satellite orbits are identified by all their TLE data sets
+    hash.add( static_cast<unsigned long>( Satellite::ephemerisStep ) );
+    for ( const auto &source : satellites ) {
+        hash.add( source->getId() );
+        hash.add( source->getName() );
+        hash.add( static_cast<unsigned long>( source->getTleData().size() ) );
+        for ( const auto &tle : source->getTleData() ) {
+            for ( const auto &line : tle ) {
+                hash.add( line );
+            }
+        }
+    }
+    key_ = hash.get();
+
+    char buffer[17];
+    snprintf( buffer, sizeof( buffer ), "%016llx", static_cast<unsigned long long>( key_ ) );
+    fileName_ = directory;
+    if ( !fileName_.empty() && fileName_.back() != '/' ) {
+        fileName_.push_back( '/' );
+    }
+    fileName_.append( "azel_" ).append( station.getName() ).append( "_" ).append( buffer ).append( ".bin" );
+}
+
+
+bool AzElCache::load( Station &station ) const noexcept {
+    try {
+        ifstream test( fileName_ );
+        if ( !test.good() ) {
+            return false;
+        }
+        test.close();
+
+        boost::interprocess::file_mapping file( fileName_.c_str(), boost::interprocess::read_only );
+        boost::interprocess::mapped_region region( file, boost::interprocess::read_only );
+        const auto *data = static_cast<const char *>( region.get_address() );
+        size_t size = region.get_size();
+
+        Header header{};
+        if ( size < sizeof( Header ) ) {
+            return false;
+        }
+        memcpy( &header, data, sizeof( Header ) );
+        if ( memcmp( header.magic, magic_, sizeof( magic_ ) ) != 0 || header.key != key_ ||
+             header.nSources != station.azelGrid_.size() ) {
+            return false;
+        }
+
+        // validate complete file before modifying station
+        size_t offset = sizeof( Header );
+        for ( uint64_t i = 0; i < header.nTables; ++i ) {
+            TableHeader table{};
+            if ( size < offset + sizeof( TableHeader ) ) {
+                return false;
+            }
+            memcpy( &table, data + offset, sizeof( TableHeader ) );
+            offset += sizeof( TableHeader ) + 4 * sizeof( double ) * table.n;
+            if ( table.srcid >= header.nSources || table.step == 0 || size < offset ) {
+                return false;
+            }
+        }
+
+        offset = sizeof( Header );
+        for ( uint64_t i = 0; i < header.nTables; ++i ) {
+            TableHeader table{};
+            memcpy( &table, data + offset, sizeof( TableHeader ) );
+            offset += sizeof( TableHeader );
+
+            Station::AzElGrid &grid = station.azelGrid_[table.srcid];
+            grid.step = table.step;
+            grid.cubic = table.cubic != 0;
+            for ( vector<double> *v : { &grid.az, &grid.el, &grid.ha, &grid.dc } ) {
+                v->resize( table.n );
+                memcpy( v->data(), data + offset, sizeof( double ) * table.n );
+                offset += sizeof( double ) * table.n;
+            }
+        }
+        return true;
+    } catch ( const boost::interprocess::interprocess_exception & ) {
+        return false;
+    }
+}
+
+
+bool AzElCache::save( const Station &station ) const noexcept {
+    // write to unique temporary file first, rename is atomic for concurrent readers
+    random_device rd;
+    string tmpName = ( boost::format( "%s.%08x.tmp" ) % fileName_ % rd() ).str();
+    {
+        ofstream of( tmpName, ios::binary );
+        if ( !of.good() ) {
+            return false;
+        }
+
+        Header header{};
+        memcpy( header.magic, magic_, sizeof( magic_ ) );
+        header.key = key_;
+        header.nSources = station.azelGrid_.size();
+        header.nTables = 0;
+        for ( const auto &grid : station.azelGrid_ ) {
+            if ( !grid.az.empty() ) {
+                ++header.nTables;
+            }
+        }
+        of.write( reinterpret_cast<const char *>( &header ), sizeof( Header ) );
+
+        for ( unsigned long srcid = 0; srcid < station.azelGrid_.size(); ++srcid ) {
+            const Station::AzElGrid &grid = station.azelGrid_[srcid];
+            if ( grid.az.empty() ) {
+                continue;
+            }
+            TableHeader table{};
+            table.srcid = static_cast<uint32_t>( srcid );
+            table.step = grid.step;
+            table.cubic = grid.cubic ? 1 : 0;
+            table.n = static_cast<uint32_t>( grid.az.size() );
+            of.write( reinterpret_cast<const char *>( &table ), sizeof( TableHeader ) );
+            for ( const vector<double> *v : { &grid.az, &grid.el, &grid.ha, &grid.dc } ) {
+                of.write( reinterpret_cast<const char *>( v->data() ), sizeof( double ) * v->size() );
+            }
+        }
+        if ( !of.good() ) {
+            of.close();
+            remove( tmpName.c_str() );
+            return false;
+        }
+    }
+    if ( rename( tmpName.c_str(), fileName_.c_str() ) != 0 ) {
+        remove( tmpName.c_str() );
+        return false;
+    }
+    return true;
+}
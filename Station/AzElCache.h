@@ -0,0 +1,148 @@
+/*
+ *  VieSched++ Very Long Baseline Interferometry (VLBI) Scheduling Software
+ *  Copyright (C) 2018  Matthias Schartner
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file AzElCache.h
+ * @brief class AzElCache
+ *
+ * @author Matthias Schartner
+ * @date 15.10.2026
+ */
+
+#ifndef AZELCACHE_H
+#define AZELCACHE_H
+
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../Source/AbstractSource.h"
+#include "../Source/Quasar.h"
+#include "../Source/Satellite.h"
+
+
+namespace VieVS {
+
+class Station;
+
+/**
+ * @class AzElCache
+ * @brief persistent on disk cache of the azimuth/elevation lookup tables of a station
+ *
+ * The lookup tables calculated in Station::precalcAzEl() are stored as one binary file per station and input hash.
+ * The hash contains station position, source coordinates, session start, duration and time steps. The file name
+ * contains the hash, the file header repeats it for validation.
+ *
+ * Files are read via a read only memory mapping and written to a temporary file which is renamed afterwards,
+ * therefore several processes can share the same cache directory.
+ *
+ * @author Matthias Schartner
+ * @date 15.10.2026
+ */
+class AzElCache {
+   public:
+    static std::string directory;  ///< cache directory, empty if cache is disabled
+
+
+    /**
+     * @brief constructor
+     * @author Matthias Schartner
+     *
+     * @param station station
+     * @param quasars list of all quasars
+     * @param satellites list of all satellites
+     * @param stepQuasar time step of quasar lookup tables in seconds
+     * @param stepSatellite time step of satellite lookup tables in seconds
+     * @param end end time of lookup tables in seconds since session start
+     */
+    AzElCache( const Station &station, const std::vector<std::shared_ptr<const Quasar>> &quasars,
+               const std::vector<std::shared_ptr<const Satellite>> &satellites, unsigned int stepQuasar,
+               unsigned int stepSatellite, unsigned int end );
+
+
+    /**
+     * @brief getter for hash of inputs
+     * @author Matthias Schartner
+     *
+     * @return hash of inputs
+     */
+    uint64_t getKey() const noexcept { return key_; }
+
+
+    /**
+     * @brief getter for cache file name
+     * @author Matthias Schartner
+     *
+     * @return cache file name
+     */
+    const std::string &getFileName() const noexcept { return fileName_; }
+
+
+    /**
+     * @brief read lookup tables from cache file
+     * @author Matthias Schartner
+     *
+     * @param station station
+     * @return true if file exists and is valid
+     */
+    bool load( Station &station ) const noexcept;
+
+
+    /**
+     * @brief write lookup tables to cache file
+     * @author Matthias Schartner
+     *
+     * @param station station
+     * @return true if file was written
+     */
+    bool save( const Station &station ) const noexcept;
+
+
+   private:
+    static constexpr char magic_[8] = { 'V', 'S', 'A', 'Z', 'E', 'L', '0', '1' };  ///< file format identifier
+
+    /**
+     * @brief file header
+     * @author Matthias Schartner
+     */
+    struct Header {
+        char magic[8];        ///< file format identifier
+        uint64_t key;         ///< hash of inputs
+        uint64_t nSources;    ///< number of source ids of station
+        uint64_t nTables;     ///< number of stored lookup tables
+    };
+
+    /**
+     * @brief header of one lookup table, followed by azimuth, elevation, hour angle and declination
+     * @author Matthias Schartner
+     */
+    struct TableHeader {
+        uint32_t srcid;  ///< source id
+        uint32_t step;   ///< time step in seconds
+        uint32_t cubic;  ///< flag if values are suited for cubic interpolation
+        uint32_t n;      ///< number of values
+    };
+
+    uint64_t key_;          ///< hash of inputs
+    std::string fileName_;  ///< cache file name
+};
+}  // namespace VieVS
+
+#endif  // AZELCACHE_H
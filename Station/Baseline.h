@@ -33,6 +33,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "../Misc/BandRegistry.h"
 #include "../Misc/VieVS_NamedObject.h"
 
 
@@ -110,7 +111,7 @@ class Baseline : public VieVS_NamedObject {
         double weight = 1;                               ///< weight of this baseline
         unsigned int minScan = 0;                        ///< minimum scan time in seconds
         unsigned int maxScan = 9999;                     ///< maximum scan time in seconds
-        std::unordered_map<std::string, double> minSNR;  ///< minimum signal to noise ration for each band
+        BandMap<double> minSNR;                          ///< minimum signal to noise ration for each band
     };
 
 
@@ -243,6 +244,16 @@ class Baseline : public VieVS_NamedObject {
      */
     void setNextEvent( unsigned int idx ) noexcept { nextEvent_ = idx; }
 
+    /**
+     * @brief get next event index
+     * @author Matthias Schartner
+     *
+     * parameters set by events only change if this index changes
+     *
+     * @return next event index
+     */
+    unsigned int getNextEvent() const noexcept { return nextEvent_; }
+
 
     /**
      * @brief set baseline statistics
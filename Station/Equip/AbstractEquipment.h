@@ -13,6 +13,7 @@
 #include <utility>
 #include <vector>
 
+#include "../../Misc/BandRegistry.h"
 #include "../../Misc/VieVS_Object.h"
 
 
@@ -35,6 +36,17 @@ class AbstractEquipment : VieVS_Object {
      */
     virtual double getSEFD( const std::string &band, double el ) const noexcept = 0;
 
+    /**
+     * @brief get SEFD value for given band id and elevation
+     *
+     * Lookup through dense per band id arrays, used during scheduling.
+     *
+     * @param bandId band id (see BandRegistry)
+     * @param el elevation
+     * @return SEFD of this band
+     */
+    virtual double getSEFD( unsigned long bandId, double el ) const noexcept = 0;
+
     //    /**
     //     * @brief returns vector of bands for which SEFD information is available
     //     * @author Matthias Schartner
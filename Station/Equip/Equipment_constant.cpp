@@ -30,7 +30,15 @@ using namespace std;
 using namespace VieVS;
 
 Equipment_constant::Equipment_constant( unordered_map<string, double> SEFDs )
-    : AbstractEquipment(), SEFD_{ std::move( SEFDs ) } {}
+    : AbstractEquipment(), SEFD_{ std::move( SEFDs ) } {
+    for ( const auto &any : SEFD_ ) {
+        unsigned long bandId = BandRegistry::id( any.first );
+        if ( bandId >= SEFDById_.size() ) {
+            SEFDById_.resize( bandId + 1, 0 );
+        }
+        SEFDById_[bandId] = any.second;
+    }
+}
 
 
 double Equipment_constant::getMaxSEFD() const noexcept {
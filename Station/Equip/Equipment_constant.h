@@ -74,6 +74,18 @@ class Equipment_constant : public AbstractEquipment {
         }
     };
 
+    /**
+     * @brief getter function for antenna SEFD information
+     * @author Matthias Schartner
+     *
+     * @param bandId band id
+     * @param el elevation
+     * @return SEFD of this band
+     */
+    double getSEFD( unsigned long bandId, double el ) const noexcept override {
+        return bandId < SEFDById_.size() ? SEFDById_[bandId] : 0;
+    };
+
     //    /**
     //     *
     //     */
@@ -121,6 +133,7 @@ class Equipment_constant : public AbstractEquipment {
 
    private:
     std::unordered_map<std::string, double> SEFD_;  ///< SEFD information per band
+    std::vector<double> SEFDById_;                  ///< SEFD information per band id (0 if band is missing)
 };
 }  // namespace VieVS
 #endif /* EQUIPMENT_H */
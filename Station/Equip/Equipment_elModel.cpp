@@ -31,26 +31,55 @@ Equipment_elModel::Equipment_elModel( std::unordered_map<std::string, double> SE
       SEFDs_{ std::move( SEFDs ) },
       y_{ std::move( SEFD_y ) },
       c0_{ std::move( SEFD_c0 ) },
-      c1_{ std::move( SEFD_c1 ) } {}
+      c1_{ std::move( SEFD_c1 ) } {
+    for ( const auto &any : SEFDs_ ) {
+        const string &band = any.first;
+        if ( y_.find( band ) == y_.end() || c0_.find( band ) == c0_.end() || c1_.find( band ) == c1_.end() ) {
+            continue;
+        }
+        unsigned long bandId = BandRegistry::id( band );
+        if ( bandId >= modelById_.size() ) {
+            modelById_.resize( bandId + 1 );
+        }
+        Model &m = modelById_[bandId];
+        m.valid = true;
+        m.SEFD = any.second;
+        m.y = y_.at( band );
+        m.c0 = c0_.at( band );
+        m.c1 = c1_.at( band );
+    }
+}
 
 
 double Equipment_elModel::getSEFD( const std::string &band, double el ) const noexcept {
     if ( SEFDs_.at( band ) == 0 ) {
         return 0;
     }
+    return model( SEFDs_.at( band ), y_.at( band ), c0_.at( band ), c1_.at( band ), el );
+}
+
+
+double Equipment_elModel::getSEFD( unsigned long bandId, double el ) const noexcept {
+    if ( bandId >= modelById_.size() || !modelById_[bandId].valid ) {
+        return getSEFD( BandRegistry::name( bandId ), el );
+    }
+    const Model &m = modelById_[bandId];
+    return model( m.SEFD, m.y, m.c0, m.c1, el );
+}
 
 
-    double y = y_.at( band );
-    double c0 = c0_.at( band );
-    double c1 = c1_.at( band );
+double Equipment_elModel::model( double SEFD, double y, double c0, double c1, double el ) noexcept {
+    if ( SEFD == 0 ) {
+        return 0;
+    }
 
     double tmp = pow( sin( el ), y );
     double tmp2 = c0 + c1 / tmp;
 
     if ( tmp2 < 1 ) {
-        return SEFDs_.at( band );
+        return SEFD;
     } else {
-        return SEFDs_.at( band ) * tmp2;
+        return SEFD * tmp2;
     }
 }
 
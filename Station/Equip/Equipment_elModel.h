@@ -66,6 +66,16 @@ class Equipment_elModel : public AbstractEquipment {
      */
     double getSEFD( const std::string &band, double el ) const noexcept override;
 
+    /**
+     * @brief getter function for antenna SEFD information
+     * @author Matthias Schartner
+     *
+     * @param bandId band id
+     * @param el elevation
+     * @return SEFD of this band
+     */
+    double getSEFD( unsigned long bandId, double el ) const noexcept override;
+
     /**
      * @brief returns maximum SEFD of this antenna
      * @author Matthias Schartner
@@ -100,10 +110,37 @@ class Equipment_elModel : public AbstractEquipment {
     std::string elevationDependence_skdFormat() const noexcept override;
 
    private:
+    /**
+     * @brief elevation dependent SEFD parameters of one band
+     * @author Matthias Schartner
+     */
+    struct Model {
+        bool valid = false;  ///< flag if parameters are available
+        double SEFD = 0;     ///< SEFD parameter
+        double y = 0;        ///< elevation dependent SEFD parameter "y"
+        double c0 = 0;       ///< elevation dependent SEFD parameter "c0"
+        double c1 = 0;       ///< elevation dependent SEFD parameter "c1"
+    };
+
     std::unordered_map<std::string, double> SEFDs_;  ///< SEFD parameters
     std::unordered_map<std::string, double> y_;      ///< elevation dependent SEFD parameter "y"
     std::unordered_map<std::string, double> c0_;     ///< elevation dependent SEFD parameter "c0"
     std::unordered_map<std::string, double> c1_;     ///< elevation dependent SEFD parameter "c1"
+    std::vector<Model> modelById_;                   ///< SEFD parameters per band id
+
+
+    /**
+     * @brief evaluate elevation dependent SEFD model
+     * @author Matthias Schartner
+     *
+     * @param SEFD SEFD parameter
+     * @param y elevation dependent SEFD parameter "y"
+     * @param c0 elevation dependent SEFD parameter "c0"
+     * @param c1 elevation dependent SEFD parameter "c1"
+     * @param el elevation
+     * @return SEFD
+     */
+    static double model( double SEFD, double y, double c0, double c1, double el ) noexcept;
 };
 }  // namespace VieVS
 
@@ -25,35 +25,55 @@ using namespace VieVS;
 
 Equipment_elTable::Equipment_elTable( std::unordered_map<std::string, std::vector<double>> elevation,
                                       std::unordered_map<std::string, std::vector<double>> SEFD )
-    : AbstractEquipment(), el_{ std::move( elevation ) }, SEFD_{ std::move( SEFD ) } {}
+    : AbstractEquipment(), el_{ std::move( elevation ) }, SEFD_{ std::move( SEFD ) } {
+    for ( const auto& any : el_ ) {
+        unsigned long bandId = BandRegistry::id( any.first );
+        if ( bandId >= elById_.size() ) {
+            elById_.resize( bandId + 1 );
+            SEFDById_.resize( bandId + 1 );
+        }
+        elById_[bandId] = any.second;
+        SEFDById_[bandId] = SEFD_.at( any.first );
+    }
+}
 
 
 double Equipment_elTable::getSEFD( const string& band, double el ) const noexcept {
     if ( el_.find( band ) != el_.end() ) {
-        const auto& tel = el_.at( band );
-        const auto& tSEFD = SEFD_.at( band );
-
-        if ( el <= tel.front() ) {
-            return tSEFD[0];
-        }
-        if ( el >= tel.back() ) {
-            return tSEFD.back();
-        }
-
-        unsigned int idx = 1;
-        while ( el >= tel[idx] ) {
-            ++idx;
-        }
-        double dy = tSEFD[idx] - tSEFD[idx - 1];
-        double dx = ( el - tel[idx - 1] ) / ( tel[idx] - tel[idx - 1] );
-        double y_ = tSEFD[idx - 1] + dy * dx;
-        return y_;
+        return interpolate( el_.at( band ), SEFD_.at( band ), el );
     } else {
         return 999999999;
     }
     return 999999999;
 }
 
+
+double Equipment_elTable::getSEFD( unsigned long bandId, double el ) const noexcept {
+    if ( bandId < elById_.size() && !elById_[bandId].empty() ) {
+        return interpolate( elById_[bandId], SEFDById_[bandId], el );
+    }
+    return 999999999;
+}
+
+
+double Equipment_elTable::interpolate( const vector<double>& tel, const vector<double>& tSEFD, double el ) noexcept {
+    if ( el <= tel.front() ) {
+        return tSEFD[0];
+    }
+    if ( el >= tel.back() ) {
+        return tSEFD.back();
+    }
+
+    unsigned int idx = 1;
+    while ( el >= tel[idx] ) {
+        ++idx;
+    }
+    double dy = tSEFD[idx] - tSEFD[idx - 1];
+    double dx = ( el - tel[idx - 1] ) / ( tel[idx] - tel[idx - 1] );
+    double y_ = tSEFD[idx - 1] + dy * dx;
+    return y_;
+}
+
 std::string Equipment_elTable::shortSummary( const string& band ) const noexcept {
     if ( SEFD_.find( band ) == SEFD_.end() ) {
         return ( boost::format( "%7s %7s %7s %7s" ) % "---" % "---" % "---" % "---" ).str();
@@ -65,6 +65,16 @@ class Equipment_elTable : public AbstractEquipment {
      */
     double getSEFD( const std::string &band, double el ) const noexcept override;
 
+    /**
+     * @brief getter function for antenna SEFD information
+     * @author Matthias Schartner
+     *
+     * @param bandId band id
+     * @param el elevation
+     * @return SEFD of this band
+     */
+    double getSEFD( unsigned long bandId, double el ) const noexcept override;
+
     /**
      * @brief returns maximum SEFD of this antenna
      * @author Matthias Schartner
@@ -100,6 +110,20 @@ class Equipment_elTable : public AbstractEquipment {
    private:
     std::unordered_map<std::string, std::vector<double>> el_;    ///< elevation angle
     std::unordered_map<std::string, std::vector<double>> SEFD_;  ///< corresponding SEFD value
+    std::vector<std::vector<double>> elById_;                    ///< elevation angle per band id
+    std::vector<std::vector<double>> SEFDById_;                  ///< corresponding SEFD value per band id
+
+
+    /**
+     * @brief interpolate SEFD in lookup table
+     * @author Matthias Schartner
+     *
+     * @param tel elevation angle knots
+     * @param tSEFD corresponding SEFD values
+     * @param el elevation
+     * @return SEFD
+     */
+    static double interpolate( const std::vector<double> &tel, const std::vector<double> &tSEFD, double el ) noexcept;
 };
 }  // namespace VieVS
 
@@ -51,13 +51,18 @@ void Network::addStation( Station station ) {
             BOOST_LOG_TRIVIAL( debug ) << "Baseline " << bl.getName() << " successfully created " << bl.printId();
 #endif
         baselines_.push_back( std::move( bl ) );
-        staids2blid_[{ any.getId(), station.getId() }] = baselines_.back().getId();
+        unsigned long idx = util::pairIndex( any.getId(), station.getId() );
+        if ( idx >= staids2blid_.size() ) {
+            staids2blid_.resize( idx + 1 );
+            staids2dxyz_.resize( idx + 1 );
+        }
+        staids2blid_[idx] = baselines_.back().getId();
 
         // create delta xyz
         double dx = any.getPosition()->getX() - station.getPosition()->getX();
         double dy = any.getPosition()->getY() - station.getPosition()->getY();
         double dz = any.getPosition()->getZ() - station.getPosition()->getZ();
-        staids2dxyz_[{ any.getId(), station.getId() }] = { dx, dy, dz };
+        staids2dxyz_[idx] = { dx, dy, dz };
     }
     // finally push back station
     stations_.push_back( std::move( station ) );
@@ -93,12 +98,7 @@ const Baseline &Network::getBaseline( unsigned long id ) const noexcept { return
 
 
 const Baseline &Network::getBaseline( unsigned long staid1, unsigned long staid2 ) const noexcept {
-    if ( staid1 > staid2 ) {
-        swap( staid1, staid2 );
-    }
-
-    unsigned long blid = staids2blid_.at( { staid1, staid2 } );
-    return baselines_[blid];
+    return baselines_[staids2blid_[util::pairIndex( staid1, staid2 )]];
 }
 
 
@@ -156,11 +156,7 @@ Baseline &Network::refBaseline( unsigned long id ) { return baselines_[id]; }
 
 
 Baseline &Network::refBaseline( unsigned long staid1, unsigned long staid2 ) {
-    if ( staid1 > staid2 ) {
-        swap( staid1, staid2 );
-    }
-
-    return baselines_[staids2blid_[{ staid1, staid2 }]];
+    return baselines_[staids2blid_[util::pairIndex( staid1, staid2 )]];
 }
 
 
@@ -188,12 +184,12 @@ std::vector<Baseline> &Network::refBaselines() { return baselines_; }
 
 
 unsigned long Network::getBlid( unsigned long staid1, unsigned long staid2 ) const noexcept {
-    return getBaseline( staid1, staid2 ).getId();
+    return staids2blid_[util::pairIndex( staid1, staid2 )];
 }
 
 
 unsigned long Network::getBlid( const std::pair<unsigned long, unsigned long> &staids ) const noexcept {
-    return getBaseline( staids.first, staids.second ).getId();
+    return getBlid( staids.first, staids.second );
 }
 
 
@@ -219,11 +215,7 @@ void Network::update( unsigned long blid, bool influence ) { baselines_[blid].up
 
 
 const std::vector<double> &Network::getDxyz( unsigned long staid1, unsigned long staid2 ) const {
-    if ( staid1 > staid2 ) {
-        swap( staid1, staid2 );
-    }
-
-    return staids2dxyz_.at( { staid1, staid2 } );
+    return staids2dxyz_.at( util::pairIndex( staid1, staid2 ) );
 }
 
 
@@ -31,6 +31,7 @@
 #include <vector>
 
 #include "../Misc/VieVS_Object.h"
+#include "../Misc/util.h"
 #include "../ObservingMode/ObservingMode.h"
 #include "Baseline.h"
 #include "SkyCoverage.h"
@@ -452,12 +453,11 @@ class Network : public VieVS_Object {
     std::vector<Baseline> baselines_;        ///< all baselines
     std::vector<SkyCoverage> skyCoverages_;  ///< all sky coverages
 
-    std::map<std::pair<unsigned long, unsigned long>, unsigned long> staids2blid_;  ///< lookup table for baseline id
+    std::vector<unsigned long> staids2blid_;  ///< lookup table for baseline id per station pair (see util::pairIndex)
 
     static unsigned long nextId;  ///< next id for this object type
 
-    std::map<std::pair<unsigned long, unsigned long>, std::vector<double>>
-        staids2dxyz_;  ///< lookup table for baseline vectors
+    std::vector<std::vector<double>> staids2dxyz_;  ///< lookup table for baseline vectors per station pair
 
     double maxDistBetweenCorrespondingTelescopes_;  ///< maximum distance between corresponding telescopes in meteres
     std::map<unsigned long, unsigned long> staids2skyCoverageId_;  ///< lookup table for sky coverage ids
@@ -37,18 +37,37 @@ SkyCoverage::SkyCoverage( string name, double maxInfluenceTime, double maxInflue
       maxInfluenceTime{ maxInfluenceTime },
       maxInfluenceDistance{ maxInfluenceDistance * deg2rad },
       interpolationTime{ interpolationTime },
-      interpolationDistance{ interpolationDistance } {}
+      interpolationDistance{ interpolationDistance } {
+    rebuildIndex();
+}
 
 
 double SkyCoverage::calcScore( const PointingVector &pv ) const {
     double score = 1;
-    for ( const auto &pv_old : pointingVectors_ ) {
-        if ( pv_old.getTime() > pv.getTime() ) {
-            continue;
-        }
-        double thisScore = scorePerPointingVector( pv, pv_old );
-        if ( thisScore < score ) {
-            score = thisScore;
+
+    // only pointing vectors within maxInfluenceTime and maxInfluenceDistance in elevation can lower the score
+    unsigned int time = pv.getTime();
+    auto lastBucket = static_cast<long>( time / bucketTime_ );
+    auto firstBucket = static_cast<long>( floor( ( time - maxInfluenceTime ) / bucketTime_ ) );
+    firstBucket = max( 0l, firstBucket );
+    lastBucket = min( lastBucket, static_cast<long>( index_.size() ) - 1 );
+
+    unsigned int band = bandIndex( pv.getEl() );
+    unsigned int firstBand = band == 0 ? 0 : band - 1;
+    unsigned int lastBand = min( nBands_ - 1, band + 1 );
+
+    for ( long bucket = firstBucket; bucket <= lastBucket; ++bucket ) {
+        const auto &bands = index_[bucket];
+        for ( unsigned int i = firstBand; i <= lastBand; ++i ) {
+            for ( const auto &pv_old : bands[i] ) {
+                if ( pv_old.getTime() > time ) {
+                    continue;
+                }
+                double thisScore = scorePerPointingVector( pv, pv_old );
+                if ( thisScore < score ) {
+                    score = thisScore;
+                }
+            }
         }
     }
 
@@ -56,7 +75,30 @@ double SkyCoverage::calcScore( const PointingVector &pv ) const {
 }
 
 
-void SkyCoverage::update( const PointingVector &pv ) noexcept { pointingVectors_.push_back( pv ); }
+void SkyCoverage::update( const PointingVector &pv ) noexcept {
+    pointingVectors_.push_back( pv );
+    addToIndex( pv );
+}
+
+
+void SkyCoverage::rebuildIndex() {
+    bucketTime_ = max( 60u, static_cast<unsigned int>( ceil( maxInfluenceTime ) ) );
+    bandHeight_ = max( 1e-3, maxInfluenceDistance );
+    nBands_ = static_cast<unsigned int>( ceil( pi / bandHeight_ ) ) + 1;
+    index_.clear();
+    for ( const auto &pv : pointingVectors_ ) {
+        addToIndex( pv );
+    }
+}
+
+
+void SkyCoverage::addToIndex( const PointingVector &pv ) {
+    unsigned long bucket = pv.getTime() / bucketTime_;
+    if ( bucket >= index_.size() ) {
+        index_.resize( bucket + 1, vector<vector<PointingVector>>( nBands_ ) );
+    }
+    index_[bucket][bandIndex( pv.getEl() )].push_back( pv );
+}
 
 
 double SkyCoverage::scorePerPointingVector( const PointingVector &pv_new,
@@ -116,7 +158,10 @@ double SkyCoverage::scorePerPointingVector( const PointingVector &pv_new,
 }
 
 
-void SkyCoverage::clearObservations() { pointingVectors_.clear(); }
+void SkyCoverage::clearObservations() {
+    pointingVectors_.clear();
+    index_.clear();
+}
 
 
 void SkyCoverage::calculateSkyCoverageScores() {
@@ -124,114 +169,83 @@ void SkyCoverage::calculateSkyCoverageScores() {
         pointingVectors_.begin(), pointingVectors_.end(),
         []( const PointingVector &left, const PointingVector &right ) { return left.getTime() < right.getTime(); } );
 
-    a13m8_ = skyCoverageScore_13( 480 );
-    a25m8_ = skyCoverageScore_25( 480 );
-    a37m8_ = skyCoverageScore_37( 480 );
-    a13m15_ = skyCoverageScore_13( 900 );
-    a25m15_ = skyCoverageScore_25( 900 );
-    a37m15_ = skyCoverageScore_37( 900 );
-    a13m30_ = skyCoverageScore_13( 1800 );
-    a25m30_ = skyCoverageScore_25( 1800 );
-    a37m30_ = skyCoverageScore_37( 1800 );
-    a13m60_ = skyCoverageScore_13( 3600 );
-    a25m60_ = skyCoverageScore_25( 3600 );
-    a37m60_ = skyCoverageScore_37( 3600 );
-}
-
-
-double SkyCoverage::skyCoverageScore_13( unsigned int deltaTime ) const {
-    double total_score = 0;
-
+    double *results[4][3] = { { &a13m8_, &a25m8_, &a37m8_ },
+                              { &a13m15_, &a25m15_, &a37m15_ },
+                              { &a13m30_, &a25m30_, &a37m30_ },
+                              { &a13m60_, &a25m60_, &a37m60_ } };
     if ( pointingVectors_.empty() ) {
-        return 0;
-    }
-
-    auto thisPv = pointingVectors_.begin();
-    int c = 0;
-    for ( unsigned int startTime = 0; startTime < TimeSystem::duration; startTime += deltaTime / 2 ) {
-        unsigned int endTime = startTime += deltaTime;
-
-        set<int> areas1;
-        set<int> areas2;
-        while ( thisPv != pointingVectors_.end() && thisPv->getTime() < endTime ) {
-            areas1.insert( areaIndex13_v1( *thisPv ) );
-            areas2.insert( areaIndex13_v2( *thisPv ) );
-
-            ++thisPv;
+        for ( auto &result : results ) {
+            for ( double *r : result ) {
+                *r = 0;
+            }
         }
-
-        double score = static_cast<double>( areas1.size() ) / 2.0 +
-                       static_cast<double>( areas2.size() ) / 2.0;  // average of both distributions
-        total_score += score / 13.0;                                // normalize score
-        ++c;
+        return;
     }
-    total_score /= c;
-
-    return total_score;
-}
-
 
-double SkyCoverage::skyCoverageScore_25( unsigned int deltaTime ) const {
-    double total_score = 0;
-
-    if ( pointingVectors_.empty() ) {
-        return 0;
+    // occupied areas of both distributions with 13, 25 and 37 areas as bitmask per window
+    constexpr int nDist = 3;
+    const double nAreas[nDist] = { 13.0, 25.0, 37.0 };
+    struct Window {
+        unsigned int deltaTime;       ///< window length
+        unsigned int startTime = 0;   ///< start time of current window
+        unsigned int endTime = 0;     ///< end time of current window
+        bool active = false;          ///< flag if window is inside session
+        uint64_t v1[nDist] = {};      ///< occupied areas (first distribution)
+        uint64_t v2[nDist] = {};      ///< occupied areas (second distribution)
+        double total[nDist] = {};     ///< sum of scores
+        int c = 0;                    ///< number of windows
+    };
+    // each window is deltaTime long, next window starts deltaTime/2 after end
+    Window windows[4];
+    const unsigned int deltaTimes[4] = { 480, 900, 1800, 3600 };
+    for ( int i = 0; i < 4; ++i ) {
+        Window &w = windows[i];
+        w.deltaTime = deltaTimes[i];
+        w.active = w.startTime < TimeSystem::duration;
+        w.endTime = w.startTime + w.deltaTime;
     }
-
-    auto thisPv = pointingVectors_.begin();
-    int c = 0;
-    for ( unsigned int startTime = 0; startTime < TimeSystem::duration; startTime += deltaTime / 2 ) {
-        unsigned int endTime = startTime += deltaTime;
-
-        set<int> areas1;
-        set<int> areas2;
-        while ( thisPv != pointingVectors_.end() && thisPv->getTime() < endTime ) {
-            areas1.insert( areaIndex25_v1( *thisPv ) );
-            areas2.insert( areaIndex25_v2( *thisPv ) );
-
-            ++thisPv;
+    auto finishWindow = [&]( Window &w ) {
+        for ( int k = 0; k < nDist; ++k ) {
+            double score = static_cast<double>( bitset<64>( w.v1[k] ).count() ) / 2.0 +
+                           static_cast<double>( bitset<64>( w.v2[k] ).count() ) / 2.0;  // average of both
+            w.total[k] += score / nAreas[k];                                              // normalize score
+            w.v1[k] = 0;
+            w.v2[k] = 0;
+        }
+        ++w.c;
+        w.startTime = w.endTime + w.deltaTime / 2;
+        w.active = w.startTime < TimeSystem::duration;
+        w.endTime = w.startTime + w.deltaTime;
+    };
+
+    for ( const auto &pv : pointingVectors_ ) {
+        // area indices are independent of window length
+        uint64_t v1[nDist] = { 1ull << areaIndex13_v1( pv ), 1ull << areaIndex25_v1( pv ),
+                               1ull << areaIndex37_v1( pv ) };
+        uint64_t v2[nDist] = { 1ull << areaIndex13_v2( pv ), 1ull << areaIndex25_v2( pv ),
+                               1ull << areaIndex37_v2( pv ) };
+        for ( auto &w : windows ) {
+            while ( w.active && pv.getTime() >= w.endTime ) {
+                finishWindow( w );
+            }
+            if ( w.active ) {
+                for ( int k = 0; k < nDist; ++k ) {
+                    w.v1[k] |= v1[k];
+                    w.v2[k] |= v2[k];
+                }
+            }
         }
-
-        double score = static_cast<double>( areas1.size() ) / 2.0 +
-                       static_cast<double>( areas2.size() ) / 2.0;  // average of both distributions
-        total_score += score / 25.0;                                // normalize score
-        ++c;
     }
-    total_score /= c;
 
-    return total_score;
-}
-
-
-double SkyCoverage::skyCoverageScore_37( unsigned int deltaTime ) const {
-    double total_score = 0;
-
-    if ( pointingVectors_.empty() ) {
-        return 0;
-    }
-
-    auto thisPv = pointingVectors_.begin();
-    int c = 0;
-    for ( unsigned int startTime = 0; startTime < TimeSystem::duration; startTime += deltaTime / 2 ) {
-        unsigned int endTime = startTime += deltaTime;
-
-        set<int> areas1;
-        set<int> areas2;
-        while ( thisPv != pointingVectors_.end() && thisPv->getTime() < endTime ) {
-            areas1.insert( areaIndex37_v1( *thisPv ) );
-            areas2.insert( areaIndex37_v2( *thisPv ) );
-
-            ++thisPv;
+    for ( int i = 0; i < 4; ++i ) {
+        Window &w = windows[i];
+        while ( w.active ) {
+            finishWindow( w );
+        }
+        for ( int k = 0; k < nDist; ++k ) {
+            *results[i][k] = w.total[k] / w.c;
         }
-
-        double score = static_cast<double>( areas1.size() ) / 2.0 +
-                       static_cast<double>( areas2.size() ) / 2.0;  // average of both distributions
-        total_score += score / 37.0;                                // normalize score
-        ++c;
     }
-    total_score /= c;
-
-    return total_score;
 }
 
 
@@ -28,7 +28,9 @@
 #define SKYCOVERAGE_H
 
 
+#include <bitset>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <limits>
 #include <set>
@@ -261,9 +263,15 @@ class SkyCoverage : public VieVS_NamedObject {
      */
     double getSkyCoverageScore_a37m60() const { return a37m60_; }
 
-    void setInfluenceDistance( double dist ) { maxInfluenceDistance = dist * deg2rad; }
+    void setInfluenceDistance( double dist ) {
+        maxInfluenceDistance = dist * deg2rad;
+        rebuildIndex();
+    }
 
-    void setInfluenceTime( double time ) { maxInfluenceTime = time; }
+    void setInfluenceTime( double time ) {
+        maxInfluenceTime = time;
+        rebuildIndex();
+    }
 
     void setInterpolationDistance( Interpolation type ) { interpolationDistance = type; }
 
@@ -288,6 +296,11 @@ class SkyCoverage : public VieVS_NamedObject {
 
 
     std::vector<PointingVector> pointingVectors_;  ///< all pointing vectors
+
+    unsigned int bucketTime_ = 0;  ///< duration of time bucket of index in seconds
+    double bandHeight_ = 0;        ///< height of elevation band of index in radians
+    unsigned int nBands_ = 0;      ///< number of elevation bands of index
+    std::vector<std::vector<std::vector<PointingVector>>> index_;  ///< pointing vectors per time bucket and band
     double a13m8_{ 0 };                            ///< sky coverage score with 13 areas over 15 minutes
     double a25m8_{ 0 };                            ///< sky coverage score with 25 areas over 15 minutes
     double a37m8_{ 0 };                            ///< sky coverage score with 37 areas over 15 minutes
@@ -301,40 +314,41 @@ class SkyCoverage : public VieVS_NamedObject {
     double a25m60_{ 0 };                           ///< sky coverage score with 25 areas over 60 minutes
     double a37m60_{ 0 };                           ///< sky coverage score with 37 areas over 60 minutes
 
+
     /**
-     * @brief calculate total sky coverage score of all observations over schedule session
+     * @brief rebuild index of pointing vectors after change of influence time or distance
      * @author Matthias Schartner
      *
-     * The sky is distributed in 13 areas
-     *
-     * @param deltaTime time increment
-     * @return sky coverage score. Maximum score is 1, minimum score is 0.
+     * Time buckets are at least maxInfluenceTime long and elevation bands are at least maxInfluenceDistance high.
+     * Therefore, all pointing vectors with an influence on a new observation are in the current or previous time
+     * bucket and in the current or neighbouring elevation band.
      */
-    double skyCoverageScore_13( unsigned int deltaTime ) const;
+    void rebuildIndex();
 
 
     /**
-     * @brief calculate total sky coverage score of all observations over schedule session
+     * @brief add pointing vector to index
      * @author Matthias Schartner
      *
-     * The sky is distributed in 25 areas
-     *
-     * @param deltaTime time increment
-     * @return sky coverage score. Maximum score is 1, minimum score is 0.
+     * @param pv pointing vector
      */
-    double skyCoverageScore_25( unsigned int deltaTime ) const;
+    void addToIndex( const PointingVector &pv );
 
 
     /**
-     * @brief calculate total sky coverage score of all observations over schedule session
+     * @brief elevation band index
      * @author Matthias Schartner
      *
-     * The sky is distributed in 37 areas
-     *
-     * @param deltaTime time increment
-     * @return sky coverage score. Maximum score is 1, minimum score is 0.
+     * @param el elevation
+     * @return elevation band index
      */
-    double skyCoverageScore_37( unsigned int deltaTime ) const;
+    unsigned int bandIndex( double el ) const noexcept {
+        double band = ( el + halfpi ) / bandHeight_;
+        if ( band <= 0 ) {
+            return 0;
+        }
+        return std::min( nBands_ - 1, static_cast<unsigned int>( band ) );
+    }
 
 
     /**
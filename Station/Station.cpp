@@ -23,8 +23,12 @@
  * Created on June 21, 2017, 1:43 PM
  */
 
+// clang-format off
+#include "../Eigen/Core"
+// clang-format on
 #include "Station.h"
 
+#include "../Misc/EarthOrientation.h"
 #include "../Misc/LookupTable.h"
 
 
@@ -32,6 +36,28 @@ using namespace std;
 using namespace VieVS;
 unsigned long VieVS::Station::nextId = 0;
 unsigned long VieVS::Station::Parameters::nextId = 0;
+unsigned long VieVS::Station::rigorousCacheSize = 4096;
+thread_local bool VieVS::Station::rigorousCacheReadOnly = false;
+Station::AzelModel VieVS::Station::trackingModel = Station::AzelModel::rigorous;
+
+namespace {
+/**
+ * @brief number of rigorous cache slots
+ * @author Matthias Schartner
+ *
+ * slots are selected with a bit mask, therefore rigorousCacheSize is rounded up to a power of two
+ *
+ * @param size requested number of slots
+ * @return number of slots
+ */
+unsigned long rigorousCacheSlots( unsigned long size ) noexcept {
+    unsigned long n = 1;
+    while ( n < size ) {
+        n *= 2;
+    }
+    return n;
+}
+}  // namespace
 
 void Station::Parameters::setParameters( const Station::Parameters &other ) {
     firstScan = other.firstScan;
@@ -76,13 +102,15 @@ Station::Station( std::string sta_name, std::string tlc, std::shared_ptr<Abstrac
       mask_{ move( sta_mask ) },
       currentPositionVector_{ PointingVector( nextId - 1, numeric_limits<unsigned long>::max() ) },
       parameters_{ Parameters( "empty" ) },
-      azelPrecalc_{ vector<vector<PointingVector>>( nSources ) } {
+      azelGrid_{ vector<AzElGrid>( nSources ) },
+      rigorousCache_{ vector<RigorousEntry>( rigorousCacheSlots( rigorousCacheSize ) ) } {
     parameters_.firstScan = true;
 }
 
 
 void Station::setCurrentPointingVector( const PointingVector &pointingVector ) noexcept {
     currentPositionVector_ = pointingVector;
+    ++revision_;
 }
 
 
@@ -107,152 +135,313 @@ bool Station::isVisible( const PointingVector &p, double minElevationSource ) co
 
 
 void Station::calcAzEl_simple( std::shared_ptr<const AbstractSource> source, PointingVector &p ) const noexcept {
-    auto &precalc = azelPrecalc_[source->getId()];
+    const AzElGrid &grid = azelGrid_[source->getId()];
 
     unsigned int time = p.getTime();
 
-    auto it_n = precalc.begin();
-    // iterate over each precalculated value
-    for ( it_n; it_n < precalc.end(); ++it_n ) {
-        if ( it_n->getTime() >= time ) {
-            break;
-        }
-    }
+    // index of interval start
+    unsigned long i_p = time / grid.step;
     // check if a precalculated value matches time exactly
-    if ( it_n->getTime() == time ) {
-        p.setAz( it_n->getAz() );
-        p.setEl( it_n->getEl() );
-        p.setHa( it_n->getHa() );
-        p.setDc( it_n->getDc() );
+    if ( time % grid.step == 0 && i_p < grid.az.size() ) {
+        p.setAz( grid.az[i_p] );
+        p.setEl( grid.el[i_p] );
+        p.setHa( grid.ha[i_p] );
+        p.setDc( grid.dc[i_p] );
         return;
     }
+    // extrapolate with last interval if time is after end of lookup table
+    if ( i_p + 1 >= grid.az.size() ) {
+        i_p = grid.az.size() - 2;
+    }
+    unsigned long i_n = i_p + 1;
 
-    auto it_p = std::prev( it_n );
-
-    int dt = it_n->getTime() - it_p->getTime();
-    double factor = static_cast<double>( time - it_p->getTime() ) / static_cast<double>( dt );
+    double factor = static_cast<double>( static_cast<long>( time ) - static_cast<long>( i_p * grid.step ) ) /
+                    static_cast<double>( grid.step );
 
-    double az1 = it_p->getAz();
-    double az2 = it_n->getAz();
-    double az;
-    if ( abs( az1 - az2 ) > halfpi ) {
-        if ( az1 < az2 ) {
-            az1 += twopi;
-        } else {
-            az2 += twopi;
-        }
-        az = it_p->getAz() + factor * ( it_n->getAz() - it_p->getAz() );
+    double az = grid.az[i_p] + factor * ( grid.az[i_n] - grid.az[i_p] );
+    if ( abs( grid.az[i_p] - grid.az[i_n] ) > halfpi ) {
         while ( az > twopi ) {
             az -= twopi;
         }
-    } else {
-        az = it_p->getAz() + factor * ( it_n->getAz() - it_p->getAz() );
     }
 
-    double el = it_p->getEl() + factor * ( it_n->getEl() - it_p->getEl() );
+    double el = grid.el[i_p] + factor * ( grid.el[i_n] - grid.el[i_p] );
 
-    double ha1 = it_p->getHa();
-    double ha2 = it_n->getHa();
-    double ha;
-    if ( abs( ha1 - ha2 ) > halfpi ) {
-        if ( ha1 < ha2 ) {
-            ha1 += twopi;
-        } else {
-            ha2 += twopi;
-        }
-        ha = it_p->getHa() + factor * ( it_n->getHa() - it_p->getHa() );
+    double ha = grid.ha[i_p] + factor * ( grid.ha[i_n] - grid.ha[i_p] );
+    if ( abs( grid.ha[i_p] - grid.ha[i_n] ) > halfpi ) {
         while ( ha > twopi ) {
             ha -= twopi;
         }
-    } else {
-        ha = it_p->getHa() + factor * ( it_n->getHa() - it_p->getHa() );
     }
 
     p.setAz( az );
     p.setEl( el );
     p.setHa( ha );
-    p.setDc( it_n->getDc() );
+    p.setDc( grid.dc[i_n] );
 }
 
 
-void Station::calcAzEl_rigorous( const shared_ptr<const AbstractSource> &source, PointingVector &p ) noexcept {
+void Station::precalcAzEl( const std::shared_ptr<const AbstractSource> &source, unsigned int step,
+                           unsigned int end ) noexcept {
+    AzElGrid &grid = azelGrid_[source->getId()];
+    grid.step = step;
+    unsigned long n = ( end + step - 1 ) / step;
+    grid.az.resize( n );
+    grid.el.resize( n );
+    grid.ha.resize( n );
+    grid.dc.resize( n );
+
+    PointingVector npv( getId(), source->getId() );
+    for ( unsigned long i = 0; i < n; ++i ) {
+        npv.setTime( static_cast<unsigned int>( i * step ) );
+        computeAzEl_rigorous( source, npv );
+        grid.az[i] = npv.getAz();
+        grid.el[i] = npv.getEl();
+        grid.ha[i] = npv.getHa();
+        grid.dc[i] = npv.getDc();
+    }
+}
+
+
+void Station::precalcAzEl( const std::vector<std::shared_ptr<const Quasar>> &quasars, unsigned int step,
+                           unsigned int end ) noexcept {
+    long nsrc = static_cast<long>( quasars.size() );
+    if ( nsrc == 0 ) {
+        return;
+    }
+    unsigned long n = ( end + step - 1 ) / step;
+    for ( const auto &source : quasars ) {
+        AzElGrid &grid = azelGrid_[source->getId()];
+        grid.step = step;
+        grid.cubic = true;
+        grid.az.resize( n );
+        grid.el.resize( n );
+        grid.ha.resize( n );
+        grid.dc.resize( n );
+    }
+
+    // aberration (time independent for quasars)
+    double omega = 7.2921151467069805e-05;  // 1.00273781191135448*D2PI/86400;
+    Eigen::Vector3d k1a_t1( ( AstronomicalParameters::earth_velocity[0] - omega * position_->getX() ) / CMPS,
+                            ( AstronomicalParameters::earth_velocity[1] + omega * position_->getY() ) / CMPS,
+                            AstronomicalParameters::earth_velocity[2] / CMPS );
+    Eigen::Matrix<double, 3, Eigen::Dynamic> k1a( 3, nsrc );
+    Eigen::ArrayXd ra( nsrc );
+    Eigen::ArrayXd de( nsrc );
+    for ( long i = 0; i < nsrc; ++i ) {
+        const vector<double> &scrs = quasars[i]->getSourceInCrs();
+        Eigen::Vector3d rqu( scrs[0], scrs[1], scrs[2] );
+        k1a.col( i ) = ( rqu + k1a_t1 ) - rqu.dot( k1a_t1 ) * rqu;
+        auto srcRaDe = quasars[i]->getRaDe( 0, position_ );
+        ra[i] = srcRaDe.first;
+        de[i] = srcRaDe.second;
+    }
+
+    const auto &g2l2 = position_->getGeodetic2Local();
+    Eigen::Matrix3d g2l;
+    g2l << g2l2[0][0], g2l2[0][1], g2l2[0][2], g2l2[1][0], g2l2[1][1], g2l2[1][2], g2l2[2][0], g2l2[2][1], g2l2[2][2];
+
+    Eigen::Matrix<double, 3, Eigen::Dynamic> lq( 3, nsrc );
+    Eigen::ArrayXd el( nsrc );
+    for ( unsigned long it = 0; it < n; ++it ) {
+        const EarthOrientation::Epoch &epoch = EarthOrientation::get( static_cast<unsigned int>( it * step ) );
+        Eigen::Matrix3d c2t;
+        c2t << epoch.c2t[0][0], epoch.c2t[0][1], epoch.c2t[0][2], epoch.c2t[1][0], epoch.c2t[1][1],
+            epoch.c2t[1][2], epoch.c2t[2][0], epoch.c2t[2][1], epoch.c2t[2][2];
+
+        //  sources in TRS and in local system
+        lq.noalias() = g2l * ( c2t * k1a );
+        el = DPI / 2 - lq.row( 2 ).transpose().array().acos();
+
+        for ( long i = 0; i < nsrc; ++i ) {
+            double saz = atan2( lq( 1, i ), lq( 0, i ) );
+            if ( lq( 1, i ) < 0 ) {
+                saz = DPI * 2 + saz;
+            }
+            double az = fmod( saz + DPI, DPI * 2 );
+
+            double ha = epoch.gmst + position_->getLon() - ra[i];
+            while ( ha > pi ) {
+                ha = ha - twopi;
+            }
+            while ( ha < -pi ) {
+                ha = ha + twopi;
+            }
+
+            AzElGrid &grid = azelGrid_[quasars[i]->getId()];
+            grid.az[it] = az;
+            grid.el[it] = el[i];
+            grid.ha[it] = ha;
+            grid.dc[it] = de[i];
+        }
+    }
+}
+
+
+bool Station::calcAzEl_interpolated( const std::shared_ptr<const AbstractSource> &source,
+                                     PointingVector &p ) const noexcept {
+    // azimuth changes too fast for interpolation close to zenith
+    constexpr double maxElevation = 80 * deg2rad;
+
+    const AzElGrid &grid = azelGrid_[source->getId()];
+    auto n = static_cast<long>( grid.az.size() );
+    if ( !grid.cubic || n < 4 ) {
+        return false;
+    }
     unsigned int time = p.getTime();
+    if ( time > ( n - 1 ) * grid.step ) {
+        return false;
+    }
 
-    auto &precalc = azelPrecalc_[source->getId()];
+    // four nodes i0 ... i0+3 around interval of time
+    long i0 = static_cast<long>( time / grid.step ) - 1;
+    if ( i0 < 0 ) {
+        i0 = 0;
+    } else if ( i0 > n - 4 ) {
+        i0 = n - 4;
+    }
+    for ( long k = i0; k < i0 + 4; ++k ) {
+        if ( grid.el[k] > maxElevation ) {
+            return false;
+        }
+    }
 
-    auto it = precalc.begin();
-    // iterate over each precalculated value
-    for ( ; it < precalc.end(); ++it ) {
-        if ( it->getTime() >= time ) {
-            break;
+    // lagrange weights
+    double x = ( static_cast<double>( time ) - static_cast<double>( i0 * grid.step ) ) / grid.step;
+    double w[4] = { -( x - 1 ) * ( x - 2 ) * ( x - 3 ) / 6, x * ( x - 2 ) * ( x - 3 ) / 2,
+                    -x * ( x - 1 ) * ( x - 3 ) / 2, x * ( x - 1 ) * ( x - 2 ) / 6 };
+
+    // interpolate angle after removing 2pi jumps between nodes
+    auto interpolateAngle = [&]( const vector<double> &v ) {
+        double prev = v[i0];
+        double sum = w[0] * prev;
+        for ( int k = 1; k < 4; ++k ) {
+            double a = v[i0 + k];
+            while ( a - prev > pi ) {
+                a -= twopi;
+            }
+            while ( a - prev < -pi ) {
+                a += twopi;
+            }
+            sum += w[k] * a;
+            prev = a;
         }
+        return sum;
+    };
+    auto interpolate = [&]( const vector<double> &v ) {
+        return w[0] * v[i0] + w[1] * v[i0 + 1] + w[2] * v[i0 + 2] + w[3] * v[i0 + 3];
+    };
+
+    double az = fmod( interpolateAngle( grid.az ), twopi );
+    if ( az < 0 ) {
+        az += twopi;
+    }
+    double ha = interpolateAngle( grid.ha );
+    while ( ha > pi ) {
+        ha = ha - twopi;
+    }
+    while ( ha < -pi ) {
+        ha = ha + twopi;
     }
 
-    // check if a precalculated value matches time exactly
-    if ( it != precalc.end() && it->getTime() == time ) {
-        p.setAz( it->getAz() );
-        p.setEl( it->getEl() );
-        p.setHa( it->getHa() );
-        p.setDc( it->getDc() );
-        return;
+    p.setAz( az );
+    p.setEl( interpolate( grid.el ) );
+    p.setHa( ha );
+    p.setDc( interpolate( grid.dc ) );
+    return true;
+}
+
+
+std::tuple<double, double, unsigned long> Station::validateAzElInterpolation(
+    const std::shared_ptr<const AbstractSource> &source, unsigned int step ) const noexcept {
+    double maxDeltaAz = 0;
+    double maxDeltaEl = 0;
+    unsigned long n = 0;
+
+    const AzElGrid &grid = azelGrid_[source->getId()];
+    if ( grid.az.empty() ) {
+        return std::make_tuple( maxDeltaAz, maxDeltaEl, n );
     }
+    auto end = static_cast<unsigned int>( ( grid.az.size() - 1 ) * grid.step );
+    PointingVector interpolated( getId(), source->getId() );
+    PointingVector rigorous( getId(), source->getId() );
+    for ( unsigned int t = 0; t <= end; t += step ) {
+        interpolated.setTime( t );
+        if ( !calcAzEl_interpolated( source, interpolated ) ) {
+            continue;
+        }
+        rigorous.setTime( t );
+        computeAzEl_rigorous( source, rigorous );
 
-#ifdef VIESCHEDPP_LOG
-    if ( Flags::logTrace )
-        BOOST_LOG_TRIVIAL( trace ) << "station " << this->getName() << " calculate azimuth and elevation to source "
-                                   << p.getSrcid();
-#endif
+        double deltaAz = abs( interpolated.getAz() - rigorous.getAz() );
+        if ( deltaAz > pi ) {
+            deltaAz = twopi - deltaAz;
+        }
+        maxDeltaAz = max( maxDeltaAz, deltaAz * cos( rigorous.getEl() ) );
+        maxDeltaEl = max( maxDeltaEl, abs( interpolated.getEl() - rigorous.getEl() ) );
+        ++n;
+    }
+    return std::make_tuple( maxDeltaAz, maxDeltaEl, n );
+}
 
-    double omega = 7.2921151467069805e-05;  // 1.00273781191135448*D2PI/86400;
 
-    //  TIME
-    double date1 = 2400000.5;
-    double mjd = TimeSystem::mjdStart + static_cast<double>( time ) / 86400.0;
+void Station::calcAzEl_rigorous( const shared_ptr<const AbstractSource> &source, PointingVector &p ) noexcept {
+    unsigned long srcid = source->getId();
+    unsigned int time = p.getTime();
 
-    // Earth Rotation
-    double ERA = iauEra00( date1, mjd );
+    // check if this station/source/time was already calculated
+    RigorousEntry &entry = rigorousCache_[( srcid * 73856093ul ^ time * 19349663ul ) & ( rigorousCache_.size() - 1 )];
+    if ( entry.srcid == srcid && entry.time == time ) {
+        p.setAz( entry.az );
+        p.setEl( entry.el );
+        p.setHa( entry.ha );
+        p.setDc( entry.dc );
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++rigorousHits_;
+        return;
+    }
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+    ++rigorousMisses_;
 
-    // precession nutation
-    double C[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+    computeAzEl_rigorous( source, p );
 
-    // TODO: change to helper functions
-    unsigned int nut_precalc_idx = 0;
-    while ( AstronomicalParameters::earth_nutTime[nut_precalc_idx + 1] < time ) {
-        ++nut_precalc_idx;
+    // result is not stored if other threads might access this cache concurrently (e.g. speculative rigorous updates)
+    if ( rigorousCacheReadOnly ) {
+        return;
     }
-    unsigned int delta = AstronomicalParameters::earth_nutTime[1] - AstronomicalParameters::earth_nutTime[0];
+    entry.srcid = srcid;
+    entry.time = time;
+    entry.az = p.getAz();
+    entry.el = p.getEl();
+    entry.ha = p.getHa();
+    entry.dc = p.getDc();
+}
 
-    unsigned int deltaTime = time - AstronomicalParameters::earth_nutTime[nut_precalc_idx];
 
-    double x = AstronomicalParameters::earth_nutX[nut_precalc_idx] +
-               ( AstronomicalParameters::earth_nutX[nut_precalc_idx + 1] -
-                 AstronomicalParameters::earth_nutX[nut_precalc_idx] ) /
-                   delta * deltaTime;
-    double y = AstronomicalParameters::earth_nutY[nut_precalc_idx] +
-               ( AstronomicalParameters::earth_nutY[nut_precalc_idx + 1] -
-                 AstronomicalParameters::earth_nutY[nut_precalc_idx] ) /
-                   delta * deltaTime;
-    double s = AstronomicalParameters::earth_nutS[nut_precalc_idx] +
-               ( AstronomicalParameters::earth_nutS[nut_precalc_idx + 1] -
-                 AstronomicalParameters::earth_nutS[nut_precalc_idx] ) /
-                   delta * deltaTime;
+void Station::computeAzEl_rigorous( const std::shared_ptr<const AbstractSource> &source,
+                                    PointingVector &p ) const noexcept {
+    unsigned int time = p.getTime();
 
-    iauC2ixys( x, y, s, C );
+#ifdef VIESCHEDPP_LOG
+    if ( Flags::logTrace )
+        BOOST_LOG_TRIVIAL( trace ) << "station " << this->getName() << " calculate azimuth and elevation to source "
+                                   << p.getSrcid();
+#endif
+
+    double omega = 7.2921151467069805e-05;  // 1.00273781191135448*D2PI/86400;
 
-    //  Polar Motion
-    double W[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
-    //  GCRS to ITRS
+    // station and source independent earth orientation
+    const EarthOrientation::Epoch &epoch = EarthOrientation::get( time );
     double c2t[3][3];
-    iauC2tcio( C, ERA, W, c2t );
-    double t2c[3][3] = {};
-    iauTr( c2t, t2c );
+    copy( &epoch.c2t[0][0], &epoch.c2t[0][0] + 9, &c2t[0][0] );
 
     //  Transformation
     double v1[3] = { -omega * position_->getX(), omega * position_->getY(), 0 };
 
-    double v1R[3] = {};
-    iauRxp( t2c, v1, v1R );
-
     double k1a[3] = {};
     double k1a_t1[3];
 
@@ -302,7 +491,7 @@ void Station::calcAzEl_rigorous( const shared_ptr<const AbstractSource> &source,
     p.setEl( el );
 
     // only for hadc antennas
-    double gmst = TimeSystem::mjd2gmst( mjd );
+    double gmst = epoch.gmst;
     auto srcRaDe = source->getRaDe( time, position_ );
 
     double ha = gmst + position_->getLon() - srcRaDe.first;
@@ -317,8 +506,6 @@ void Station::calcAzEl_rigorous( const shared_ptr<const AbstractSource> &source,
     // end of hadc part
 
     p.setTime( time );
-
-    precalc.push_back( p );
 }
 
 
@@ -376,6 +563,7 @@ void Station::update( unsigned long nbl, const PointingVector &end, bool addToSt
     }
     ++nTotalScans_;
     currentPositionVector_ = end;
+    ++revision_;
 
     if ( parameters_.firstScan ) {
         parameters_.firstScan = false;
@@ -401,6 +589,7 @@ bool Station::checkForNewEvent( unsigned int time, bool &hardBreak ) noexcept {
         }
         nextEvent_++;
         flag = true;
+        ++revision_;
     }
     return flag;
 }
@@ -455,6 +644,7 @@ void Station::applyNextEvent( std::ofstream &of ) noexcept {
         of << "## changing parameters for station: " << boost::format( "%8s" ) % getName() << " ##\n";
         of << "###############################################\n";
         nextEvent_++;
+        ++revision_;
     }
 }
 
@@ -475,6 +665,7 @@ void Station::clearObservations() {
     totalObsTime_ = 0;
 
     parameters_.firstScan = true;
+    ++revision_;
 }
 
 
@@ -33,16 +33,20 @@
 #include <boost/lexical_cast.hpp>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <tuple>
 #include <utility>
 
 #include "../Misc/AstronomicalParameters.h"
+#include "../Misc/BandRegistry.h"
 #include "../Misc/Constants.h"
 #include "../Misc/TimeSystem.h"
 #include "../Misc/VieVS_NamedObject.h"
 #include "../Misc/sofa.h"
 #include "../Scan/PointingVector.h"
 #include "../Source/AbstractSource.h"
+#include "../Source/Quasar.h"
 #include "Antenna/AbstractAntenna.h"
 #include "CableWrap/AbstractCableWrap.h"
 #include "Equip/AbstractEquipment.h"
@@ -62,16 +66,24 @@ namespace VieVS {
  * @date 21.06.2017
  */
 class Station : public VieVS_NamedObject {
+    friend class AzElCache;
+
    public:
+    static unsigned long rigorousCacheSize;  ///< number of cached rigorous azimuth/elevation results (rounded up to power of two)
+    static thread_local bool rigorousCacheReadOnly;  ///< rigorous results of this thread are not stored in cache
+
     /**
      * @brief azimuth elevation calculation model
      * @author Matthias Schartner
      */
     enum class AzelModel {
-        simple,   ///< simple model without nutation
-        rigorous  ///< rigorous model
+        simple,        ///< simple model without nutation
+        rigorous,      ///< rigorous model
+        interpolated,  ///< cubic interpolation of rigorous model
     };
 
+    static AzelModel trackingModel;  ///< model used for checks during tracking (see calcAzEl_tracking())
+
 
     /**
      * @brief station parameters
@@ -107,7 +119,7 @@ class Station : public VieVS_NamedObject {
         double weight = 1;                  ///< multiplicative factor of score for scans with this station
         double minElevation = 5 * deg2rad;  /// minimum elevation in radians
 
-        std::unordered_map<std::string, double> minSNR;  ///< minimum required signal to noise ration for each band
+        BandMap<double> minSNR;  ///< minimum required signal to noise ration for each band
 
         unsigned int minSlewtime = 0;            ///< minimum required slew time
         unsigned int maxSlewtime = 600;          ///< maximum allowed slewtime in seconds
@@ -272,6 +284,55 @@ class Station : public VieVS_NamedObject {
      */
     Parameters &referencePARA() { return parameters_; }
 
+
+    /**
+     * @brief set flag if next scan is the first scan of this station
+     * @author Matthias Schartner
+     *
+     * @param flag true if next scan is first scan (no field system, slew and preob time)
+     */
+    void setFirstScan( bool flag ) noexcept {
+        parameters_.firstScan = flag;
+        ++revision_;
+    }
+
+
+    /**
+     * @brief set station availability
+     * @author Matthias Schartner
+     *
+     * @param flag true if station is available
+     */
+    void setAvailable( bool flag ) noexcept {
+        parameters_.available = flag;
+        ++revision_;
+    }
+
+
+    /**
+     * @brief set minimum slew time due to data write speed after a scan
+     * @author Matthias Schartner
+     *
+     * @param observingTime observation duration of last scan in seconds
+     */
+    void overheadTimeDueToDataWriteSpeed( unsigned int observingTime ) noexcept {
+        parameters_.overheadTimeDueToDataWriteSpeed( observingTime );
+        ++revision_;
+    }
+
+
+    /**
+     * @brief getter for station revision
+     * @author Matthias Schartner
+     *
+     * The revision is incremented by all setters, by update() and whenever a new event is applied. It is used to
+     * detect outdated station dependent partial results during scan selection, therefore changes during scheduling
+     * have to be done via these functions and not via referencePARA().
+     *
+     * @return station revision
+     */
+    unsigned long getRevision() const noexcept { return revision_; }
+
     /**
      * @brief getter for cable wrap
      * @author Matthias Schartner
@@ -442,22 +503,125 @@ class Station : public VieVS_NamedObject {
      * @brief calculation of azimuth, elevation, hour angle and declination with rigorouse model
      * @author Matthias Schartner
      *
+     * Results are stored in a bounded cache (direct mapped, rigorousCacheSize entries) keyed by source id and time.
+     * Results are not stored if rigorousCacheReadOnly is set for the calling thread (e.g. by the worker threads of
+     * speculative rigorous updates, which run concurrently on the same station).
+     *
      * @param source observed source
      * @param p pointing vector
      */
     void calcAzEl_rigorous( const std::shared_ptr<const AbstractSource> &source, PointingVector &p ) noexcept;
 
 
+    /**
+     * @brief calculation of azimuth, elevation, hour angle and declination with cubic interpolation
+     * @author Matthias Schartner
+     *
+     * Piecewise cubic (four point Lagrange) interpolation of the rigorous lookup table filled in
+     * precalcAzEl(quasars,...). Azimuth and hour angle are unwrapped before interpolation. Interpolation is refused
+     * if the source is close to zenith (azimuth changes fast), if the source has no suitable lookup table (e.g.
+     * satellites) or if time is outside the lookup table.
+     *
+     * @param source observed source
+     * @param p pointing vector
+     * @return true if values were interpolated, false if p was not changed
+     */
+    bool calcAzEl_interpolated( const std::shared_ptr<const AbstractSource> &source, PointingVector &p ) const
+        noexcept;
+
+
+    /**
+     * @brief calculation of azimuth, elevation, hour angle and declination for checks during tracking
+     * @author Matthias Schartner
+     *
+     * Uses calcAzEl_interpolated() if trackingModel is AzelModel::interpolated and interpolation is possible,
+     * otherwise calcAzEl_rigorous().
+     *
+     * @param source observed source
+     * @param p pointing vector
+     */
+    void calcAzEl_tracking( const std::shared_ptr<const AbstractSource> &source, PointingVector &p ) noexcept {
+        if ( trackingModel == AzelModel::interpolated && calcAzEl_interpolated( source, p ) ) {
+            return;
+        }
+        calcAzEl_rigorous( source, p );
+    }
+
+
+    /**
+     * @brief maximum deviation of cubic interpolation from rigorous model
+     * @author Matthias Schartner
+     *
+     * Compares calcAzEl_interpolated() with the rigorous model every step seconds over the whole lookup table.
+     *
+     * @param source observed source
+     * @param step time step of comparison in seconds
+     * @return maximum deviation in azimuth (scaled with cos(el)) and elevation in radians, number of epochs
+     */
+    std::tuple<double, double, unsigned long> validateAzElInterpolation(
+        const std::shared_ptr<const AbstractSource> &source, unsigned int step ) const noexcept;
+
+
+    /**
+     * @brief getter for number of rigorous azimuth/elevation results taken from cache
+     * @author Matthias Schartner
+     *
+     * @return number of reused results
+     */
+    unsigned long getRigorousCacheHits() const noexcept { return rigorousHits_; }
+
+
+    /**
+     * @brief getter for number of calculated rigorous azimuth/elevation results
+     * @author Matthias Schartner
+     *
+     * @return number of calculated results
+     */
+    unsigned long getRigorousCacheMisses() const noexcept { return rigorousMisses_; }
+
+
     /**
      * @brief calculation of azimuth, elevation, hour angle and declination with lookup tables
      * @author Matthias Schartner
      *
+     * Linear interpolation between the two surrounding values of the fixed step lookup table of this source (see
+     * precalcAzEl()). The interval is found in constant time.
+     *
      * @param source observed source
      * @param p pointing vector
      */
     void calcAzEl_simple( std::shared_ptr<const AbstractSource> source, PointingVector &p ) const noexcept;
 
 
+    /**
+     * @brief fill lookup table used in calcAzEl_simple() with rigorous azimuth, elevation, hour angle and declination
+     * @author Matthias Schartner
+     *
+     * @param source observed source
+     * @param step time step in seconds
+     * @param end values are calculated for all multiples of step smaller than end (seconds since session start)
+     */
+    void precalcAzEl( const std::shared_ptr<const AbstractSource> &source, unsigned int step,
+                      unsigned int end ) noexcept;
+
+
+    /**
+     * @brief fill lookup tables used in calcAzEl_simple() of many quasars at once
+     * @author Matthias Schartner
+     *
+     * Same model as the rigorous calculation, but the transformation of all quasars is done with vectorized matrix
+     * products for each epoch. Only the order of floating point operations differs, the results agree with the
+     * rigorous calculation within 1e-12 radians. Very close to zenith elevation (acos) and azimuth (atan2) are ill
+     * conditioned and may differ up to 1e-8 radians.
+     *
+     * @param quasars observed quasars
+     * @param step time step in seconds
+     * @param end values are calculated for all multiples of step smaller than end (seconds since session start)
+     */
+    void precalcAzEl( const std::vector<std::shared_ptr<const Quasar>> &quasars, unsigned int step,
+                      unsigned int end ) noexcept;
+
+
     /**
      * @brief change current pointing vector
      * @author Matthias Schartner
@@ -476,6 +640,7 @@ class Station : public VieVS_NamedObject {
     void setEVENTS( std::vector<Event> &EVENTS ) noexcept {
         Station::events_ = move( EVENTS );
         Station::nextEvent_ = 0;
+        ++revision_;
     }
 
     /**
@@ -535,6 +700,16 @@ class Station : public VieVS_NamedObject {
      */
     void setNextEvent( unsigned int idx ) noexcept { nextEvent_ = idx; }
 
+    /**
+     * @brief get next event index
+     * @author Matthias Schartner
+     *
+     * parameters set by events only change if this index changes
+     *
+     * @return next event index
+     */
+    unsigned int getNextEvent() const noexcept { return nextEvent_; }
+
 
     /**
      * @brief update station if used for a scan
@@ -702,7 +877,38 @@ class Station : public VieVS_NamedObject {
     std::string occupation_code_ = "unknown";        ///< occupation code (e.g.: "72425901")
 
     Statistics statistics_;                                 ///< station statistics
-    std::vector<std::vector<PointingVector>> azelPrecalc_;  ///< pre calculated azimuth elevation lookup table
+
+    /**
+     * @brief fixed step lookup table of one source
+     * @author Matthias Schartner
+     *
+     * value i belongs to time i*step (seconds since session start)
+     */
+    struct AzElGrid {
+        unsigned int step = 0;   ///< time step in seconds
+        bool cubic = false;      ///< flag if values are suited for cubic interpolation
+        std::vector<double> az;  ///< azimuth
+        std::vector<double> el;  ///< elevation
+        std::vector<double> ha;  ///< hour angle
+        std::vector<double> dc;  ///< declination
+    };
+    std::vector<AzElGrid> azelGrid_;  ///< fixed step lookup table per source id
+
+    /**
+     * @brief cached rigorous azimuth, elevation, hour angle and declination
+     * @author Matthias Schartner
+     */
+    struct RigorousEntry {
+        unsigned long srcid = std::numeric_limits<unsigned long>::max();  ///< source id
+        unsigned int time = 0;                                             ///< time
+        double az = 0;                                                     ///< azimuth
+        double el = 0;                                                     ///< elevation
+        double ha = 0;                                                     ///< hour angle
+        double dc = 0;                                                     ///< declination
+    };
+    std::vector<RigorousEntry> rigorousCache_;  ///< cached rigorous results (slot from hash of source id and time)
+    unsigned long rigorousHits_ = 0;            ///< number of rigorous results taken from cache
+    unsigned long rigorousMisses_ = 0;          ///< number of calculated rigorous results
 
     Parameters parameters_;                 ///< station parameters
     PointingVector currentPositionVector_;  ///< current pointing vector
@@ -711,6 +917,17 @@ class Station : public VieVS_NamedObject {
     int nTotalScans_{ 0 };                  ///< number of total scans
     int nObs_{ 0 };                         ///< number of observed baselines
     unsigned int totalObsTime_{ 0 };        ///< total observing time in seconds
+    unsigned long revision_{ 0 };           ///< incremented whenever parameters or current pointing vector change
+
+
+    /**
+     * @brief calculation of azimuth, elevation, hour angle and declination with rigorouse model (without cache)
+     * @author Matthias Schartner
+     *
+     * @param source observed source
+     * @param p pointing vector
+     */
+    void computeAzEl_rigorous( const std::shared_ptr<const AbstractSource> &source, PointingVector &p ) const noexcept;
 };
 }  // namespace VieVS
 #endif /* STATION_H */
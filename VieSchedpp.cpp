@@ -94,12 +94,16 @@ void VieSchedpp::run() {
     init.createSources( skdCatalogs_, of );
     init.createSatellites( skdCatalogs_, of );
     init.createSpacecrafts( skdCatalogs_, of );
+    if ( xml_.get_optional<string>( "VieSchedpp.catalogs.satellite_avoid" ).is_initialized() ) {
+        init.createSatellitesToAvoid( of );
+    }
     init.createStations( skdCatalogs_, of );
     init.connectObservingMode( of );
 
     init.initializeStations();
     nsta_ = init.getNetwork().getNSta();
     init.precalcAzElStations();
+    init.initializeSatelliteAvoidance();
     init.initializeBaselines();
 
     init.precalcSubnettingSrcIds();
@@ -170,6 +174,22 @@ void VieSchedpp::run() {
 #else
         cout << boost::format( "[info] OpenMP: job scheduling %s chunk size %d\n" ) % jobScheduling % chunkSize;
         cout << boost::format( "number of threads %d\n" ) % omp_get_num_threads();
+#endif
+    } else if ( xml_.get( "VieSchedpp.multiCore.parallelScanSelection", false ) ) {
+        multiCoreSetup();
+        Subcon::parallelEvaluation = true;
+        Subcon::speculativeUpdates = xml_.get( "VieSchedpp.multiCore.speculativeRigorousUpdates", 0u );
+#ifdef VIESCHEDPP_LOG
+        BOOST_LOG_TRIVIAL( info ) << "using OpenMP to parallelize scan selection!";
+        if ( Subcon::speculativeUpdates > 1 ) {
+            BOOST_LOG_TRIVIAL( info ) << "rigorous update of best " << Subcon::speculativeUpdates
+                                      << " scans in parallel";
+        }
+#else
+        cout << "[info] using OpenMP to parallelize scan selection!\n";
+        if ( Subcon::speculativeUpdates > 1 ) {
+            cout << "[info] rigorous update of best " << Subcon::speculativeUpdates << " scans in parallel\n";
+        }
 #endif
     }
 #else